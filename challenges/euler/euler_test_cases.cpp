@@ -2,31 +2,191 @@
 
 #include "../../doctest.h"
 #include "all_euler_solutions.h"
+#include "../../utils/prime_utils.h"
 
 
 TEST_SUITE_BEGIN("Euler Test Case Solution Suite");
 
+// Known answers, checked while compiling.
+static_assert(euler::problem_1_solution() == 233168);
+static_assert(euler::problem_2_solution() == 4613732);
+static_assert(euler::problem_3_solution() == 6857);
+static_assert(euler::problem_4_solution() == 906609);
+static_assert(euler::problem_5_solution() == 232792560);
+static_assert(euler::lcm_up_to_u64(46) == 9419588158802421600ULL);
+static_assert(euler::problem_6_solution(100) == 25164150);
+
 TEST_CASE("Test solution")
 {
-	// SUBCASE("Problem 1:") {
-	// 	CHECK(euler::problem_1_solution()==233168);
-	// }
-	// SUBCASE("Problem 2:") {
-	// 	CHECK(euler::problem_2_solution()==4613732);
-	// }
-	// SUBCASE("Problem 3:") {
-	// 	CHECK(euler::problem_3_solution()==6857);
-	// }
-	// SUBCASE("Problem 4:") {
-	// 	CHECK(euler::problem_4_solution()==906609);
-	// }
-	// SUBCASE("Problem 5:") {
-	// 	CHECK(euler::problem_5_solution()==232792560);
-	// }
+	SUBCASE("Problem 1:") {
+		CHECK(euler::problem_1_solution()==233168);
+		CHECK(euler::sum_of_multiple_below_limit(1000)==233168);
+	}
+	SUBCASE("Problem 2:") {
+		CHECK(euler::problem_2_solution()==4613732);
+		CHECK(euler::even_fibonacci_below_limit(4000000)==4613732);
+	}
+	SUBCASE("Problem 3:") {
+		CHECK(euler::problem_3_solution()==6857);
+		CHECK(euler::largest_prime_factor(600851475143)==6857);
+	}
+	SUBCASE("Problem 4:") {
+		CHECK(euler::problem_4_solution()==906609);
+	}
+	SUBCASE("Problem 5:") {
+		CHECK(euler::problem_5_solution()==232792560);
+		CHECK(euler::smallest_multiple_up_to_number(20)==232792560);
+		CHECK(euler::lcm_up_to(46)==utils::big_uint(euler::lcm_up_to_u64(46)));
+		CHECK_THROWS_AS((void)euler::lcm_up_to_u64(47), std::overflow_error);
+	}
 	SUBCASE("Problem 6:") {
 		CHECK(euler::problem_6_solution(10)==2640);
 		CHECK(euler::problem_6_solution(100)==25164150);
 	}
 }
 
+TEST_CASE("Test sum_of_multiples inclusion-exclusion")
+{
+	SUBCASE("Matches brute force") {
+		const std::vector<std::uint64_t> divisors {6, 4, 9, 12, 10, 4, 35, 1001};
+		std::uint64_t expected = 0;
+		for (std::uint64_t n = 1; n < 100000; n++) {
+			if (std::ranges::any_of(divisors, [&](const std::uint64_t d) { return n % d == 0; })) {
+				expected += n;
+			}
+		}
+		CHECK(euler::sum_of_multiples(100000, divisors) == expected);
+		CHECK(euler::sum_of_multiples(1, divisors) == 0);
+		CHECK(euler::sum_of_multiples(100, std::vector<std::uint64_t> {}) == 0);
+		CHECK_THROWS_AS((void)euler::sum_of_multiples(100, std::vector<std::uint64_t> {3, 0}), std::invalid_argument);
+	}
+	SUBCASE("Twenty-five prime divisors") {
+		const std::vector<std::uint64_t> primes(utils::small_primes.begin(), utils::small_primes.begin() + 25);
+		std::uint64_t expected = 0;
+		for (std::uint64_t n = 1; n < 1000000; n++) {
+			if (std::ranges::any_of(primes, [&](const std::uint64_t p) { return n % p == 0; })) {
+				expected += n;
+			}
+		}
+		CHECK(euler::sum_of_multiples(1000000, primes) == expected);
+	}
+	SUBCASE("Limit of 1e18") {
+		const utils::uint128_t expected = utils::uint128_t {233333333333333333ULL} * 1000000000000000000ULL + 166666666666666668ULL;
+		CHECK(euler::sum_of_multiple_below_limit(1000000000000000000ULL) == expected);
+	}
+}
+
+TEST_CASE("Test descending palindrome product search")
+{
+	SUBCASE("Matches brute force") {
+		for (int digits = 1; digits <= 3; digits++) {
+			std::uint64_t low = 1;
+			for (int i = 1; i < digits; i++) {
+				low *= 10;
+			}
+			std::uint64_t expected = 0;
+			for (std::uint64_t i = low; i < low * 10; i++) {
+				for (std::uint64_t j = low; j <= i; j++) {
+					const std::string product = std::to_string(i * j);
+					if (i * j > expected && std::equal(product.begin(), product.end(), product.rbegin())) {
+						expected = i * j;
+					}
+				}
+			}
+			const euler::palindrome_product found = euler::max_palindrome_product(digits);
+			CHECK(found.palindrome == expected);
+			CHECK(utils::uint128_t {found.lhs} * found.rhs == found.palindrome);
+		}
+	}
+	SUBCASE("Up to nine-digit factors") {
+		CHECK(euler::max_palindrome_product(4).palindrome == 99000099);
+		CHECK(euler::max_palindrome_product(6).palindrome == 999000000999ULL);
+		CHECK(euler::max_palindrome_product(7).palindrome == 99956644665999ULL);
+		CHECK(euler::max_palindrome_product(8).palindrome == 9999000000009999ULL);
+		const euler::palindrome_product nine = euler::max_palindrome_product(9);
+		CHECK(nine.palindrome == 999900665566009999ULL);
+		CHECK(nine.lhs == 999980347);
+		CHECK(nine.rhs == 999920317);
+		CHECK_THROWS_AS((void)euler::max_palindrome_product(10), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Test threaded palindrome product search")
+{
+	for (const unsigned threads : {1U, 3U, 0U}) {
+		CHECK(euler::max_palindrome_produced_from_multiplication(9, threads) == 9);
+		CHECK(euler::max_palindrome_produced_from_multiplication(99, threads) == 9009);
+		CHECK(euler::max_palindrome_produced_from_multiplication(999, threads) == 906609);
+		CHECK(euler::max_palindrome_produced_from_multiplication(9999, threads) == 99000099);
+		CHECK(euler::max_palindrome_produced_from_multiplication(500, threads) == 222222);
+	}
+	CHECK(euler::max_palindrome_produced_from_multiplication(1) == 1);
+	CHECK_THROWS_AS((void)euler::max_palindrome_produced_from_multiplication(46341), std::invalid_argument);
+}
+
+TEST_CASE("Test digit vector conversion")
+{
+	CHECK(euler::int_vector_to_int({9, 0, 6, 6, 0, 9}) == 906609);
+	CHECK(euler::int_vector_to_int(euler::int_to_int_vector(2147483647)) == 2147483647);
+	CHECK(euler::int_vector_to_int({0, 0, 7}) == 7);
+	CHECK_THROWS_AS((void)euler::int_vector_to_int({}), std::invalid_argument);
+	CHECK_THROWS_AS((void)euler::int_vector_to_int({1, 10}), std::invalid_argument);
+	CHECK_THROWS_AS((void)euler::int_vector_to_int({2, 1, 4, 7, 4, 8, 3, 6, 4, 8}), std::out_of_range);
+	CHECK_THROWS_AS((void)euler::int_vector_to_int({1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}), std::out_of_range);
+}
+
+TEST_CASE("Test lcm(1..n) by prime powers")
+{
+	SUBCASE("Small n") {
+		CHECK(euler::lcm_up_to(0) == utils::big_uint(1));
+		CHECK(euler::lcm_up_to(1) == utils::big_uint(1));
+		CHECK(euler::lcm_up_to(20) == utils::big_uint(232792560));
+		CHECK(euler::lcm_up_to(100) == utils::big_uint::from_string("69720375229712477164533808935312303556800"));
+		CHECK(euler::smallest_multiple_up_to_number(22) == 232792560);
+		CHECK_THROWS_AS((void)euler::smallest_multiple_up_to_number(23), std::overflow_error);
+	}
+	SUBCASE("Matches an iterative lcm in 128 bits") {
+		utils::uint128_t expected = 1;
+		for (std::uint64_t n = 1; n <= 88; n++) {
+			expected = expected / std::gcd(expected, utils::uint128_t {n}) * n;
+			CHECK(euler::lcm_up_to(n) == utils::big_uint(expected));
+			CHECK(euler::lcm_up_to_mod(n, 1000000007) == static_cast<std::uint64_t>(expected % 1000000007));
+			CHECK(euler::lcm_up_to_mod(n, 1ULL << 40) == static_cast<std::uint64_t>(expected % (1ULL << 40)));
+		}
+	}
+	SUBCASE("n = 1e6") {
+		CHECK(euler::lcm_up_to(1000000).bit_width() == 1442099);
+		CHECK(euler::lcm_up_to_mod(1000000, 1000000007) == 814048721);
+		CHECK(euler::lcm_up_to_mod(1000000, 18446744073709551557ULL) == 14918165155315193781ULL);
+		CHECK(euler::lcm_up_to_mod(1000000, 1000000000000000000ULL) == 707859660800000000ULL);
+		CHECK(euler::lcm_up_to_mod(10000000, 998244353) == 934299388);
+		CHECK(euler::lcm_up_to_mod(1000000, 1) == 0);
+		CHECK_THROWS_AS((void)euler::lcm_up_to_mod(10, 0), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Test sum square difference closed form")
+{
+	SUBCASE("Matches summing the terms") {
+		utils::uint128_t sum = 0;
+		utils::uint128_t sum_of_squares = 0;
+		for (std::uint64_t n = 0; n <= 2000; n++) {
+			sum += n;
+			sum_of_squares += utils::uint128_t {n} * n;
+			CHECK(euler::sum_square_difference(n) == sum * sum - sum_of_squares);
+		}
+	}
+	SUBCASE("Large n and overflow") {
+		static_assert(euler::sum_square_difference(100) == 25164150);
+		CHECK(euler::sum_square_difference(1000000000) == utils::uint128_t {250000000166666666ULL} * 1000000000000000000ULL + 416666666500000000ULL);
+		const utils::uint128_t largest = euler::sum_square_difference(6074000999ULL);
+		CHECK(largest / 1000000000000000000ULL / 1000000000000000000ULL == 340);
+		CHECK(largest % 1000000000000000000ULL == 372264692488416500ULL);
+		CHECK_THROWS_AS((void)euler::sum_square_difference(6074001000ULL), std::overflow_error);
+		CHECK(euler::diff_of_sum_of_squares_vs_square_sum(77935) == 9223035548849962840LL);
+		CHECK_THROWS_AS((void)euler::diff_of_sum_of_squares_vs_square_sum(77936), std::overflow_error);
+		CHECK_THROWS_AS((void)euler::diff_of_sum_of_squares_vs_square_sum(-1), std::invalid_argument);
+	}
+}
+
 TEST_SUITE_END;
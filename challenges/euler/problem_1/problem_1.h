@@ -1,11 +1,73 @@
 #pragma once
+#include "../../../utils/utils.h"
+#include "../../../utils/int128.h"
 
 namespace  euler {
 
-	int sum_of_multiple_below_limit(int);
+	namespace detail {
+		// Sum of the positive multiples of divisor below limit.
+		constexpr utils::uint128_t sum_of_multiples_of(const std::uint64_t limit, const std::uint64_t divisor) {
+			const utils::uint128_t count = (limit - 1) / divisor;
+			return divisor * (count * (count + 1) / 2);
+		}
 
-	inline int problem_1_solution() {
-		return sum_of_multiple_below_limit(1000);
+		// Add the terms of every subset extending the current one with divisors
+		// from next onwards. Odd-sized subsets add, even-sized ones subtract;
+		// the total is exact modulo 2^128 even while it dips below zero.
+		constexpr void add_subset_terms(const std::uint64_t limit, const std::vector<std::uint64_t> &divisors, const std::size_t next,
+		                                const std::uint64_t lcm, const bool odd, utils::uint128_t &total) {
+			for (std::size_t i = next; i < divisors.size(); i++) {
+				const std::uint64_t step = divisors[i] / std::gcd(lcm, divisors[i]);
+				// No multiples below the limit, for this subset or any superset.
+				if (lcm > (limit - 1) / step) {
+					continue;
+				}
+				const std::uint64_t extended = lcm * step;
+				if (odd) {
+					total -= sum_of_multiples_of(limit, extended);
+				} else {
+					total += sum_of_multiples_of(limit, extended);
+				}
+				add_subset_terms(limit, divisors, i + 1, extended, !odd, total);
+			}
+		}
+	}
+
+	// Sum of the positive integers below limit divisible by at least one of
+	// divisors, by inclusion-exclusion over the lcms of divisor subsets.
+	// Divisors that are multiples of others are dropped first and subsets
+	// whose lcm reaches the limit are pruned with all their supersets, so
+	// sets of 20+ divisors stay fast. Exact for every 64-bit limit. Throws
+	// std::invalid_argument for a zero divisor.
+	constexpr utils::uint128_t sum_of_multiples(const std::uint64_t limit, const std::span<const std::uint64_t> divisors) {
+		if (std::ranges::find(divisors, 0) != divisors.end()) {
+			throw std::invalid_argument("Divisors must be positive.");
+		}
+		if (limit < 2) {
+			return 0;
+		}
+
+		// Multiples of d are already counted through any smaller divisor of d.
+		std::vector<std::uint64_t> sorted(divisors.begin(), divisors.end());
+		std::ranges::sort(sorted);
+		std::vector<std::uint64_t> kept {};
+		for (const std::uint64_t d : sorted) {
+			if (d < limit && std::ranges::none_of(kept, [&](const std::uint64_t k) { return d % k == 0; })) {
+				kept.push_back(d);
+			}
+		}
+
+		utils::uint128_t total = 0;
+		detail::add_subset_terms(limit, kept, 0, 1, false, total);
+		return total;
+	}
+
+	// Prints the sum of the multiples of 3 or 5 below limit.
+	utils::uint128_t sum_of_multiple_below_limit(std::uint64_t);
+
+	consteval long long problem_1_solution() {
+		constexpr std::array<std::uint64_t, 2> divisors {3, 5};
+		return static_cast<long long>(sum_of_multiples(1000, divisors));
 	};
 
-}
\ No newline at end of file
+}
@@ -1,11 +1,13 @@
 #pragma once
+#include "../../../utils/utils.h"
+#include "../../../utils/fibonacci.h"
 
 namespace  euler {
 
-	int even_fibonacci_below_limit(int);
+	std::uint64_t even_fibonacci_below_limit(std::uint64_t);
 
-	inline int problem_2_solution() {
-		return even_fibonacci_below_limit(4000000);
+	consteval long long problem_2_solution() {
+		return static_cast<long long>(utils::even_fibonacci_sum<std::uint64_t>(4000000));
 	};
 
-}
\ No newline at end of file
+}
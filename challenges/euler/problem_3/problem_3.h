@@ -1,16 +1,16 @@
 #pragma once
-#include <utility>
 #include "../../../utils/utils.h"
+#include "../../../utils/prime_utils.h"
 
 namespace  euler {
 
-	std::pair<long long, long long> find_first_factor(long long);
-
 	long long largest_prime_factor(long long);
 
 
-	inline long long problem_3_solution() {
-		return largest_prime_factor(600851475143);
+	// Trial division at compile time: 600851475143 only has factors below
+	// 7000, so this stays cheap as a constant expression.
+	consteval long long problem_3_solution() {
+		return static_cast<long long>(utils::factorize_constexpr<std::uint64_t>(600851475143).back().first);
 	};
 
 }
\ No newline at end of file
@@ -7,25 +7,34 @@
 
 namespace  euler {
 
-	int int_vector_to_int(std::vector<int> int_vector) {
-		std::stringstream ss;
-		for (int digit : int_vector) {
-			ss << digit;
+	namespace {
+		// Digits of a negative value are those of its magnitude.
+		unsigned magnitude(const int n) {
+			return n < 0 ? 0u - static_cast<unsigned>(n) : static_cast<unsigned>(n);
 		}
-		int out_in = std::stoi(ss.str());
-		return out_in;
 	}
 
-	std::vector<int> int_to_int_vector(int int_in) {
-		std::string int_str = std::to_string(int_in);
-		std::vector<int> int_vector;
-		for (auto loop_char: int_str ) {
-			if (loop_char >= '0' and loop_char <= '9') {
-				int_vector.push_back(loop_char - '0');
-			} else {
-				std::runtime_error("Character out of range.");
+	int int_vector_to_int(const std::vector<int> int_vector) {
+		if (int_vector.empty()) {
+			throw std::invalid_argument("No digits to convert.");
+		}
+		int value = 0;
+		for (const int digit : int_vector) {
+			if (digit < 0 || digit > 9) {
+				throw std::invalid_argument(std::to_string(digit) + " is not a decimal digit.");
+			}
+			if (__builtin_mul_overflow(value, 10, &value) || __builtin_add_overflow(value, digit, &value)) {
+				throw std::out_of_range("Digits do not fit in an int.");
 			}
 		}
+		return value;
+	}
+
+	std::vector<int> int_to_int_vector(const int int_in) {
+		const utils::digit_view digits(magnitude(int_in));
+		std::vector<int> int_vector(digits.size());
+		// digit_view runs least significant first; the vector is most significant first.
+		std::ranges::copy(digits, int_vector.rbegin());
 		return int_vector;
 	}
 
@@ -41,24 +50,60 @@ namespace  euler {
 	}
 
 	bool is_palindrome(const int int_in) {
-		const std::vector<int> int_vector = int_to_int_vector(int_in);
-		return is_palindrome(int_vector);
+		return utils::is_palindrome(magnitude(int_in));
 	}
 
-	int max_palindrome_produced_from_multiplication(int max_num) {
-		int max_palindrome {1};
+	int max_palindrome_produced_from_multiplication(const int max_num, unsigned threads) {
+		if (max_num > 46340) {
+			throw std::invalid_argument("Products of factors above 46340 do not fit in an int.");
+		}
+		if (max_num < 1) {
+			return 1;
+		}
+		if (threads == 0) {
+			threads = std::max(1U, std::thread::hardware_concurrency());
+		}
 
-		for (int i = 1; i <= max_num; i++) {
-			for (int j = 1; j <= i; j++) {
-				int test_num = i * j;
-				if (test_num > max_palindrome & is_palindrome(test_num)) {
-					std::cout << "New largest palindrome is: " << test_num
-					<< " from multiplying: " << i << " and " << j <<  std::endl;
-					max_palindrome = test_num;
-			}
+		// Workers claim runs of i from the top down, so large palindromes turn
+		// up early and the shared bound prunes the remaining runs.
+		constexpr int rows_per_claim = 64;
+		const int claim_count = (max_num + rows_per_claim - 1) / rows_per_claim;
+		std::atomic<int> cursor {0};
+		std::atomic<int> max_palindrome {1};
+
+		auto worker = [&] {
+			for (int claim = cursor++; claim < claim_count; claim = cursor++) {
+				const int top = max_num - claim * rows_per_claim;
+				const int bottom = std::max(1, top - rows_per_claim + 1);
+				for (int i = top; i >= bottom; i--) {
+					// Every later row is below i * i, so nothing left can win.
+					if (i * i <= max_palindrome.load(std::memory_order_relaxed)) {
+						return;
+					}
+					for (int j = i; j >= 1; j--) {
+						const int test_num = i * j;
+						int best = max_palindrome.load(std::memory_order_relaxed);
+						if (test_num <= best) {
+							break;
+						}
+						if (is_palindrome(test_num)) {
+							while (test_num > best && !max_palindrome.compare_exchange_weak(best, test_num, std::memory_order_relaxed)) {}
+							break;
+						}
+					}
+				}
 			}
+		};
+
+		std::vector<std::thread> workers {};
+		for (unsigned t = 1; t < std::min<unsigned>(threads, claim_count); t++) {
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (std::thread &thread : workers) {
+			thread.join();
 		}
-		return max_palindrome;
+		return max_palindrome.load();
 	}
 
 	int next_smallest_palindrome(int digit) {
@@ -1,9 +1,14 @@
 #pragma once
 #include <utility>
 #include "../../../utils/utils.h"
+#include "../../../utils/int128.h"
+#include "../../../utils/digit_utils.h"
 
 namespace  euler {
 
+	// The number whose decimal digits, most significant first, are given.
+	// Throws std::invalid_argument for no digits or a value outside 0..9 and
+	// std::out_of_range when the result does not fit in an int.
 	int int_vector_to_int(std::vector<int>);
 
 	std::vector<int> int_to_int_vector(int);
@@ -14,10 +19,93 @@ namespace  euler {
 
 	int create_repeated_digit_number(int digit, int n);
 
-	int max_palindrome_produced_from_multiplication(int);
+	// Largest palindromic i * j with 1 <= j <= i <= max_num, by trying the
+	// products. Rows of i are shared out to threads workers (0 uses every
+	// hardware thread) that keep a common best so far and stop each row once
+	// i * j can no longer beat it. Throws std::invalid_argument above 46340,
+	// where the products overflow an int.
+	int max_palindrome_produced_from_multiplication(int max_num, unsigned threads = 0);
 
-	inline long long problem_4_solution() {
-		return max_palindrome_produced_from_multiplication(999);
+	struct palindrome_product {
+		utils::uint128_t palindrome;
+		std::uint64_t lhs;
+		std::uint64_t rhs;
+	};
+
+	namespace detail {
+		// Factor pair of palindrome with both factors in [low, high] and the
+		// first one a multiple of step, or nullopt.
+		constexpr std::optional<palindrome_product> find_factor_pair(const std::uint64_t palindrome, const std::uint64_t low, const std::uint64_t high, const std::uint64_t step) {
+			// The cofactor stays in range only for factors in [palindrome / high, palindrome / low].
+			const std::uint64_t smallest = std::max(low, (palindrome + high - 1) / high);
+			const std::uint64_t largest = std::min(high, palindrome / low);
+			if (smallest > largest) {
+				return std::nullopt;
+			}
+			// An odd palindrome only has odd factors, and one not ending in 5 has
+			// no factor of 5, so those candidates skip the division.
+			const bool odd = palindrome % 2 == 1;
+			const bool coprime_to_5 = palindrome % 5 != 0;
+			const std::uint64_t stride = odd ? 2 * step : step;
+			std::uint64_t factor = largest / step * step;
+			if (odd && factor % 2 == 0) {
+				factor = factor >= step ? factor - step : 0;
+			}
+			for (; factor >= smallest && factor != 0; factor = factor >= stride ? factor - stride : 0) {
+				if (coprime_to_5 && factor % 5 == 0) {
+					continue;
+				}
+				if (palindrome % factor == 0) {
+					const std::uint64_t cofactor = palindrome / factor;
+					return palindrome_product {palindrome, std::max(factor, cofactor), std::min(factor, cofactor)};
+				}
+			}
+			return std::nullopt;
+		}
+	}
+
+	// Largest palindrome that is a product of two factor_digits-digit numbers,
+	// with lhs >= rhs. Palindromes are generated in descending order from
+	// their first half and each one is tested for a factor pair in
+	// [10^(k-1), 10^k) by walking only the divisors that keep the cofactor in
+	// range. Even-length palindromes are multiples of 11, so only multiples of
+	// 11 are tried as the first factor there. Takes 1 to 9 digits; throws
+	// std::invalid_argument otherwise.
+	constexpr palindrome_product max_palindrome_product(const int factor_digits) {
+		if (factor_digits < 1 || factor_digits > 9) {
+			throw std::invalid_argument("Factors must have between 1 and 9 digits.");
+		}
+		std::uint64_t low = 1;
+		for (int i = 1; i < factor_digits; i++) {
+			low *= 10;
+		}
+		const std::uint64_t high = low * 10 - 1;
+		const std::uint64_t scale = low * 10;
+
+		// Products have 2k digits, or 2k - 1 when no 2k-digit palindrome factors.
+		// A 2k-digit palindrome is its first half h followed by h reversed,
+		// which makes it a multiple of 11.
+		for (std::uint64_t half = high; half >= low; half--) {
+			const std::uint64_t palindrome = half * scale + utils::reverse_digits(half);
+			if (const auto found = detail::find_factor_pair(palindrome, low, high, 11)) {
+				return *found;
+			}
+		}
+		// A (2k - 1)-digit palindrome shares the middle digit of its first half.
+		for (std::uint64_t half = high; half >= low; half--) {
+			const std::uint64_t palindrome = half * low + utils::reverse_digits(half / 10);
+			if (palindrome < low * low) {
+				break;
+			}
+			if (const auto found = detail::find_factor_pair(palindrome, low, high, 1)) {
+				return *found;
+			}
+		}
+		throw std::logic_error("Every factor size has a palindromic product.");
+	}
+
+	consteval long long problem_4_solution() {
+		return static_cast<long long>(max_palindrome_product(3).palindrome);
 	};
 
 }
\ No newline at end of file
@@ -1,33 +1,30 @@
 #include "problem_5.h"
 
 #include "../../../utils/prime_utils.h"
+#include "../../../utils/modint.h"
 
 namespace  euler {
 	int smallest_multiple_up_to_number(const int number) {
-		std::map<int, int> repetition_of_prime_factorals {};
-
-		for (int i = 1; i <= number; i++) {
-			auto prime_factors_map = utils::prime_count_map(i);
-			std::cout << "For number " << i << " updating prime factors with: " << prime_factors_map << std::endl;
-			for (auto prime_factor_and_count: prime_factors_map) {
-				if (repetition_of_prime_factorals.contains(prime_factor_and_count.first)) {
-					repetition_of_prime_factorals[prime_factor_and_count.first] = std::max(
-						repetition_of_prime_factorals[prime_factor_and_count.first],
-						prime_factor_and_count.second
-						);
-				} else {
-					repetition_of_prime_factorals[prime_factor_and_count.first] = prime_factor_and_count.second;
-				}
-			}
+		// lcm(1..23) = 5354228880 is the first value past INT_MAX.
+		if (number > 22) {
+			throw std::overflow_error("lcm(1.." + std::to_string(number) + ") does not fit in an int.");
 		}
+		return static_cast<int>(lcm_up_to_u64(static_cast<std::uint64_t>(std::max(number, 1))));
+	}
 
-		int multiple = 1;
-		for (auto prime_factor_and_count: repetition_of_prime_factorals) {
-			std::cout << "Raising multiple: " << multiple << " by " << prime_factor_and_count.first
-			<< " to the power of " << prime_factor_and_count.second << std::endl;
-			multiple *= std::pow(prime_factor_and_count.first, prime_factor_and_count.second);
-		}
+	utils::big_uint lcm_up_to(const std::uint64_t n) {
+		return utils::product_tree(detail::largest_prime_powers(n));
+	}
 
-		return multiple;
+	std::uint64_t lcm_up_to_mod(const std::uint64_t n, const std::uint64_t m) {
+		if (m == 0) {
+			throw std::invalid_argument("Modulus must be positive.");
+		}
+		const utils::dynamic_reduction arithmetic(m);
+		std::uint64_t multiple = arithmetic.one();
+		for (const std::uint64_t power : detail::largest_prime_powers(n)) {
+			multiple = arithmetic.mul(multiple, arithmetic.to_form(power % m));
+		}
+		return arithmetic.from_form(multiple);
 	}
 }
@@ -1,14 +1,65 @@
 #pragma once
 #include "../../../utils/utils.h"
+#include "../../../utils/big_uint.h"
+#include "../../../utils/prime_utils.h"
 
 namespace  euler {
 
 	std::set<int> get_factors(int number);
 
+	namespace detail {
+		// p^floor(log_p n) for every prime p <= n, in increasing order of p.
+		// The primes come from utils::primes_up_to at run time and from
+		// utils::factorize_constexpr in constant expressions.
+		constexpr std::vector<std::uint64_t> largest_prime_powers(const std::uint64_t n) {
+			std::vector<std::uint64_t> powers {};
+			if (std::is_constant_evaluated()) {
+				for (std::uint64_t candidate = 2; candidate <= n; candidate++) {
+					if (utils::factorize_constexpr(candidate).back().first == candidate) {
+						powers.push_back(candidate);
+					}
+				}
+			} else {
+				powers = utils::primes_up_to(n);
+			}
+			for (std::uint64_t &power : powers) {
+				const std::uint64_t prime = power;
+				while (power <= n / prime) {
+					power *= prime;
+				}
+			}
+			return powers;
+		}
+	}
+
+	// Throws std::overflow_error once the result no longer fits in an int,
+	// which happens past 22.
 	int smallest_multiple_up_to_number(int number);
 
-	inline long long problem_5_solution() {
-		return smallest_multiple_up_to_number(20);
+	// lcm(1, ..., n), the product of p^floor(log_p n) over the primes p <= n.
+	// The prime powers are multiplied with utils::product_tree; n = 1e6 gives
+	// a 1.44 million bit result.
+	utils::big_uint lcm_up_to(std::uint64_t n);
+
+	// lcm(1, ..., n) mod m without building the full value. Throws
+	// std::invalid_argument for m == 0.
+	std::uint64_t lcm_up_to_mod(std::uint64_t n, std::uint64_t m);
+
+	// lcm(1, ..., n) in 64 bits. Throws std::overflow_error past n = 46.
+	constexpr std::uint64_t lcm_up_to_u64(const std::uint64_t n) {
+		// lcm(1..47) = 47 * lcm(1..46) is the first value past 2^64.
+		if (n > 46) {
+			throw std::overflow_error("lcm(1.." + std::to_string(n) + ") does not fit in 64 bits.");
+		}
+		std::uint64_t multiple = 1;
+		for (const std::uint64_t power : detail::largest_prime_powers(n)) {
+			multiple *= power;
+		}
+		return multiple;
+	}
+
+	consteval long long problem_5_solution() {
+		return static_cast<long long>(lcm_up_to_u64(20));
 	};
 
 }
\ No newline at end of file
@@ -1,9 +1,10 @@
 #include "problem_6.h"
+#include "../../../utils/utils.h"
 #include <chrono>
 #include <thread>
 
 namespace  euler {
-	long long diff_of_sum_of_squares_vs_square_sum(const long long n) {
+	long long diff_of_sum_of_squares_vs_square_sum_with_progress(const long long n) {
 		// Create two independent progress log windows:
 		//  - progress_logger_1: updated on every iteration.
 		//  - progress_logger_2: updated only when the counter is a multiple of 5.
@@ -1,6 +1,6 @@
 #pragma once
-#include "../../../utils/utils.h"
-#include <functional>
+#include "../../../utils/precompile_header.h"
+#include "../../../utils/int128.h"
 
 namespace  euler {
 	// P[i] = sum_x = 1 to i for x
@@ -16,12 +16,62 @@ namespace  euler {
 	// Compare to (3+2+1)^2 - (3^2 + 2^2 + 1^2) = 36 - 14 = 22
 	// Finally P[i] = i(i+1)/2
 	// SO S[i] = SUM_i=2 to i((x^2)(x-1))
+	// Summing that gives S[n] = (n-1)n(n+1)(3n+2)/12.
 
-	// progress_cb: optional callback receiving progress fraction in [0,1]
-	long long diff_of_sum_of_squares_vs_square_sum(long long n);
+	// (1 + ... + n)^2 - (1^2 + ... + n^2) from the closed form. The 3 and the
+	// 4 in the denominator are divided out of the factors before multiplying,
+	// so every n whose result fits in 128 bits (n <= 6074000999) is exact.
+	// Throws std::overflow_error beyond that.
+	constexpr utils::uint128_t sum_square_difference(const std::uint64_t n) {
+		if (n < 2) {
+			return 0;
+		}
+		std::array<utils::uint128_t, 4> factors {utils::uint128_t {n} - 1, n, utils::uint128_t {n} + 1, 3 * utils::uint128_t {n} + 2};
+		// One of three consecutive integers is a multiple of 3, and the
+		// product holds at least two factors of 2.
+		for (int i = 0; i < 3; i++) {
+			if (factors[i] % 3 == 0) {
+				factors[i] /= 3;
+				break;
+			}
+		}
+		int twos = 2;
+		for (utils::uint128_t &factor : factors) {
+			while (twos > 0 && factor % 2 == 0) {
+				factor /= 2;
+				twos--;
+			}
+		}
+		utils::uint128_t product = 1;
+		for (const utils::uint128_t factor : factors) {
+			if (__builtin_mul_overflow(product, factor, &product)) {
+				throw std::overflow_error("The sum square difference does not fit in 128 bits.");
+			}
+		}
+		return product;
+	}
 
-	inline long long problem_6_solution(long long n) {
+	// sum_square_difference without GUI or I/O, for n >= 0. Throws
+	// std::overflow_error once the result no longer fits in a long long,
+	// past n = 77935.
+	constexpr long long diff_of_sum_of_squares_vs_square_sum(const long long n) {
+		if (n < 0) {
+			throw std::invalid_argument("n must not be negative.");
+		}
+		const utils::uint128_t difference = sum_square_difference(static_cast<std::uint64_t>(n));
+		if (difference > static_cast<utils::uint128_t>(std::numeric_limits<long long>::max())) {
+			throw std::overflow_error("The sum square difference does not fit in a long long.");
+		}
+		return static_cast<long long>(difference);
+	}
+
+	// Demo of the progress log windows: the same sum built one term at a time
+	// while two windows track progress, sleeping 50 ms per step. Needs the UI
+	// loop running, as in main.cpp.
+	long long diff_of_sum_of_squares_vs_square_sum_with_progress(long long n);
+
+	consteval long long problem_6_solution(long long n) {
 		return diff_of_sum_of_squares_vs_square_sum(n);
 	};
 
-}
\ No newline at end of file
+}
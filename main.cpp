@@ -11,8 +11,8 @@ int main()
 
     // Start worker thread(s) which will create progress windows and perform work.
     std::thread worker([&](){
-        result_1 = euler::diff_of_sum_of_squares_vs_square_sum(100);
-        result_2 = euler::diff_of_sum_of_squares_vs_square_sum(200);
+        result_1 = euler::diff_of_sum_of_squares_vs_square_sum_with_progress(100);
+        result_2 = euler::diff_of_sum_of_squares_vs_square_sum_with_progress(200);
     });
 
     // Run the UI loop on the main thread (blocks here). This ensures glfwInit()
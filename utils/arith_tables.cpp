@@ -0,0 +1,165 @@
+#include "arith_tables.h"
+
+namespace utils {
+	namespace {
+		// Tables start on cache-line boundaries in the shared storage.
+		constexpr std::size_t table_alignment = 64;
+
+		std::size_t aligned_bytes(const std::size_t bytes) {
+			return (bytes + table_alignment - 1) / table_alignment * table_alignment;
+		}
+
+		std::uint64_t wrapping_pow(std::uint64_t base, unsigned exponent) {
+			std::uint64_t result = 1;
+			for (; exponent > 0; exponent >>= 1) {
+				if (exponent & 1) {
+					result *= base;
+				}
+				base *= base;
+			}
+			return result;
+		}
+	}
+
+	template<typename T>
+	std::span<T> arith_tables::allocate(const std::size_t count, std::size_t &offset) {
+		const std::span<T> table(reinterpret_cast<T *>(storage_.data() + offset), count);
+		offset += aligned_bytes(count * sizeof(T));
+		return table;
+	}
+
+	arith_tables::arith_tables(const std::uint32_t limit, const arith_table_options &options) : limit_(limit) {
+		const std::size_t count = std::size_t {limit} + 1;
+		const std::size_t bytes = (options.phi ? aligned_bytes(count * sizeof(std::uint32_t)) : 0)
+			+ (options.mu ? aligned_bytes(count * sizeof(std::int8_t)) : 0)
+			+ (options.sigma_k ? aligned_bytes(count * sizeof(std::uint64_t)) : 0)
+			+ (options.divisor_count ? aligned_bytes(count * sizeof(std::uint16_t)) : 0)
+			+ (options.omega ? aligned_bytes(count * sizeof(std::uint8_t)) : 0);
+
+		// Both kinds of storage start out zeroed.
+		if (options.backing_file) {
+			file_ = mapped_file::create(*options.backing_file, bytes);
+			storage_ = file_.writable_bytes();
+		} else {
+			heap_.resize(bytes / sizeof(std::uint64_t));
+			storage_ = std::as_writable_bytes(std::span(heap_));
+		}
+		std::size_t offset = 0;
+		if (options.phi) {
+			phi_ = allocate<std::uint32_t>(count, offset);
+		}
+		if (options.mu) {
+			mu_ = allocate<std::int8_t>(count, offset);
+		}
+		if (options.sigma_k) {
+			sigma_ = allocate<std::uint64_t>(count, offset);
+		}
+		if (options.divisor_count) {
+			divisor_count_ = allocate<std::uint16_t>(count, offset);
+		}
+		if (options.omega) {
+			omega_ = allocate<std::uint8_t>(count, offset);
+		}
+		if (limit < 1) {
+			return;
+		}
+
+		if (options.phi) {
+			phi_[1] = 1;
+		}
+		if (options.mu) {
+			mu_[1] = 1;
+		}
+		if (options.sigma_k) {
+			sigma_[1] = 1;
+		}
+		if (options.divisor_count) {
+			divisor_count_[1] = 1;
+		}
+		const unsigned k = options.sigma_k.value_or(0);
+		// sigma and d of p^e * rest need e, so they have to strip p from i.
+		const bool needs_exponent = options.sigma_k || options.divisor_count;
+
+		// Linear sieve: each composite n is reached once, as i * p with p its
+		// smallest prime. Then f(n) follows from f(i), and p divides i exactly
+		// when p is also the smallest prime of i.
+		std::vector<std::uint64_t> composite((count + 63) / 64);
+		std::vector<std::uint32_t> primes {};
+		for (std::uint64_t i = 2; i <= limit; i++) {
+			if ((composite[i / 64] >> (i % 64) & 1) == 0) {
+				primes.push_back(static_cast<std::uint32_t>(i));
+				if (options.phi) {
+					phi_[i] = static_cast<std::uint32_t>(i - 1);
+				}
+				if (options.mu) {
+					mu_[i] = -1;
+				}
+				if (options.sigma_k) {
+					sigma_[i] = 1 + wrapping_pow(i, k);
+				}
+				if (options.divisor_count) {
+					divisor_count_[i] = 2;
+				}
+				if (options.omega) {
+					omega_[i] = 1;
+				}
+			}
+
+			for (const std::uint32_t p : primes) {
+				const std::uint64_t n = i * p;
+				if (n > limit) {
+					break;
+				}
+				composite[n / 64] |= std::uint64_t {1} << (n % 64);
+
+				if (i % p != 0) {
+					if (options.phi) {
+						phi_[n] = phi_[i] * (p - 1);
+					}
+					if (options.mu) {
+						mu_[n] = static_cast<std::int8_t>(-mu_[i]);
+					}
+					if (options.sigma_k) {
+						sigma_[n] = sigma_[i] * (1 + wrapping_pow(p, k));
+					}
+					if (options.divisor_count) {
+						divisor_count_[n] = static_cast<std::uint16_t>(2 * divisor_count_[i]);
+					}
+					if (options.omega) {
+						omega_[n] = static_cast<std::uint8_t>(omega_[i] + 1);
+					}
+					continue;
+				}
+
+				if (options.phi) {
+					phi_[n] = phi_[i] * p;
+				}
+				if (options.omega) {
+					omega_[n] = omega_[i];
+				}
+				if (needs_exponent) {
+					// n = p^exponent * rest with p not dividing rest.
+					std::uint64_t rest = i / p;
+					unsigned exponent = 2;
+					for (; rest % p == 0; rest /= p) {
+						exponent++;
+					}
+					if (options.sigma_k) {
+						const std::uint64_t p_to_k = wrapping_pow(p, k);
+						std::uint64_t term = 1;
+						std::uint64_t power_sum = 1;
+						for (unsigned e = 0; e < exponent; e++) {
+							term *= p_to_k;
+							power_sum += term;
+						}
+						sigma_[n] = sigma_[rest] * power_sum;
+					}
+					if (options.divisor_count) {
+						divisor_count_[n] = static_cast<std::uint16_t>(divisor_count_[rest] * (exponent + 1));
+					}
+				}
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "precompile_header.h"
+#include "mapped_file.h"
+
+namespace utils {
+
+	// Which functions arith_tables fills. Unrequested tables cost nothing.
+	struct arith_table_options {
+		// Euler's totient.
+		bool phi {false};
+		// Mobius function.
+		bool mu {false};
+		// Sum of the k-th powers of the divisors, for this k. Wraps modulo
+		// 2^64 once it overflows, which for k = 2 is past about 2e9.
+		std::optional<unsigned> sigma_k {};
+		// d(n), the number of divisors.
+		bool divisor_count {false};
+		// omega(n), the number of distinct prime factors.
+		bool omega {false};
+		// Keep the tables in this file instead of on the heap, so 1e9 entries
+		// can exceed physical memory. The file is overwritten.
+		std::optional<std::filesystem::path> backing_file {};
+	};
+
+	// Multiplicative function tables for [0, limit], all filled in a single
+	// linear-sieve pass. Each function is its own contiguous array, and a
+	// table that was not requested is an empty span. Entries for 0 are 0.
+	// Besides the tables the sieve needs limit/8 bytes of flags and 4 bytes
+	// per prime.
+	class arith_tables {
+	public:
+		arith_tables(std::uint32_t limit, const arith_table_options &options);
+
+		[[nodiscard]] std::uint32_t limit() const { return limit_; }
+
+		[[nodiscard]] std::span<const std::uint32_t> phi() const { return phi_; }
+		[[nodiscard]] std::span<const std::int8_t> mu() const { return mu_; }
+		[[nodiscard]] std::span<const std::uint64_t> sigma() const { return sigma_; }
+		[[nodiscard]] std::span<const std::uint16_t> divisor_count() const { return divisor_count_; }
+		[[nodiscard]] std::span<const std::uint8_t> omega() const { return omega_; }
+
+	private:
+		// Carve the next table of count entries out of the storage.
+		template<typename T>
+		std::span<T> allocate(std::size_t count, std::size_t &offset);
+
+		std::uint32_t limit_;
+		mapped_file file_ {};
+		std::vector<std::uint64_t> heap_ {};
+		std::span<std::byte> storage_ {};
+		std::span<std::uint32_t> phi_ {};
+		std::span<std::int8_t> mu_ {};
+		std::span<std::uint64_t> sigma_ {};
+		std::span<std::uint16_t> divisor_count_ {};
+		std::span<std::uint8_t> omega_ {};
+	};
+}
@@ -0,0 +1,444 @@
+#include "big_uint.h"
+
+namespace utils {
+	namespace detail {
+		limb_buffer::limb_buffer(const limb_buffer &other) {
+			reserve(other.size_);
+			std::ranges::copy(other, data());
+			size_ = other.size_;
+		}
+
+		limb_buffer::limb_buffer(limb_buffer &&other) noexcept {
+			*this = std::move(other);
+		}
+
+		limb_buffer &limb_buffer::operator=(const limb_buffer &other) {
+			if (this != &other) {
+				size_ = 0;
+				reserve(other.size_);
+				std::ranges::copy(other, data());
+				size_ = other.size_;
+			}
+			return *this;
+		}
+
+		limb_buffer &limb_buffer::operator=(limb_buffer &&other) noexcept {
+			if (this == &other) {
+				return *this;
+			}
+			if (!is_inline()) {
+				delete[] heap_;
+			}
+			if (other.is_inline()) {
+				inline_ = other.inline_;
+			} else {
+				heap_ = other.heap_;
+				other.inline_ = {};
+			}
+			size_ = std::exchange(other.size_, 0);
+			capacity_ = std::exchange(other.capacity_, inline_capacity);
+			return *this;
+		}
+
+		limb_buffer::~limb_buffer() {
+			if (!is_inline()) {
+				delete[] heap_;
+			}
+		}
+
+		void limb_buffer::push_back(const std::uint64_t limb) {
+			if (size_ == capacity_) {
+				reserve(2 * capacity_);
+			}
+			data()[size_++] = limb;
+		}
+
+		void limb_buffer::resize(const std::size_t size) {
+			reserve(size);
+			if (size > size_) {
+				std::fill(data() + size_, data() + size, 0);
+			}
+			size_ = size;
+		}
+
+		void limb_buffer::reserve(const std::size_t capacity) {
+			if (capacity <= capacity_) {
+				return;
+			}
+			auto *grown = new std::uint64_t[capacity];
+			std::ranges::copy(*this, grown);
+			if (!is_inline()) {
+				delete[] heap_;
+			}
+			heap_ = grown;
+			capacity_ = capacity;
+		}
+
+		void limb_buffer::assign(const std::uint64_t *limbs, const std::size_t count) {
+			size_ = 0;
+			reserve(count);
+			std::copy(limbs, limbs + count, data());
+			size_ = count;
+		}
+
+		void limb_buffer::shrink_to_inline() {
+			if (is_inline() || size_ > inline_capacity) {
+				return;
+			}
+			std::array<std::uint64_t, inline_capacity> limbs {};
+			std::copy(heap_, heap_ + size_, limbs.data());
+			delete[] heap_;
+			inline_ = limbs;
+			capacity_ = inline_capacity;
+		}
+	}
+
+	namespace {
+		// Adds addend[0, addend_size) into target[0, target_size) and returns
+		// the carry out of the top.
+		std::uint64_t add_limbs(std::uint64_t *target, const std::size_t target_size, const std::uint64_t *addend, const std::size_t addend_size) {
+			std::uint64_t carry = 0;
+			for (std::size_t i = 0; i < target_size && (carry != 0 || i < addend_size); i++) {
+				const uint128_t sum = static_cast<uint128_t>(target[i]) + (i < addend_size ? addend[i] : 0) + carry;
+				target[i] = static_cast<std::uint64_t>(sum);
+				carry = static_cast<std::uint64_t>(sum >> 64);
+			}
+			return carry;
+		}
+
+		// Subtracts subtrahend from target in place and returns the borrow.
+		std::uint64_t subtract_limbs(std::uint64_t *target, const std::size_t target_size, const std::uint64_t *subtrahend, const std::size_t subtrahend_size) {
+			std::uint64_t borrow = 0;
+			for (std::size_t i = 0; i < target_size && (borrow != 0 || i < subtrahend_size); i++) {
+				const uint128_t difference = static_cast<uint128_t>(target[i]) - (i < subtrahend_size ? subtrahend[i] : 0) - borrow;
+				target[i] = static_cast<std::uint64_t>(difference);
+				borrow = static_cast<std::uint64_t>(difference >> 64) != 0 ? 1 : 0;
+			}
+			return borrow;
+		}
+
+		// Products up to this many limbs are computed on the stack.
+		constexpr std::size_t small_product_limbs = 2 * detail::limb_buffer::inline_capacity;
+
+		// product[0, lhs_size + rhs_size) = lhs * rhs.
+		void schoolbook_multiply(const std::uint64_t *lhs, const std::size_t lhs_size, const std::uint64_t *rhs, const std::size_t rhs_size, std::uint64_t *product) {
+			std::fill(product, product + lhs_size + rhs_size, 0);
+			for (std::size_t i = 0; i < lhs_size; i++) {
+				std::uint64_t carry = 0;
+				for (std::size_t j = 0; j < rhs_size; j++) {
+					const uint128_t term = static_cast<uint128_t>(lhs[i]) * rhs[j] + product[i + j] + carry;
+					product[i + j] = static_cast<std::uint64_t>(term);
+					carry = static_cast<std::uint64_t>(term >> 64);
+				}
+				product[i + rhs_size] = carry;
+			}
+		}
+
+		// product[0, 2 size) = lhs * rhs for two size-limb operands, from three
+		// half-size products: with x = x1 B + x0,
+		//     lhs * rhs = z2 B^2 + ((l0 + l1)(r0 + r1) - z2 - z0) B + z0.
+		void karatsuba_multiply(const std::uint64_t *lhs, const std::uint64_t *rhs, const std::size_t size, std::uint64_t *product) {
+			if (size < big_uint::karatsuba_threshold) {
+				schoolbook_multiply(lhs, size, rhs, size, product);
+				return;
+			}
+			const std::size_t low = size / 2;
+			const std::size_t high = size - low;
+			karatsuba_multiply(lhs, rhs, low, product);
+			karatsuba_multiply(lhs + low, rhs + low, high, product + 2 * low);
+
+			std::vector<std::uint64_t> lhs_sum(lhs + low, lhs + size);
+			std::vector<std::uint64_t> rhs_sum(rhs + low, rhs + size);
+			lhs_sum.push_back(add_limbs(lhs_sum.data(), high, lhs, low));
+			rhs_sum.push_back(add_limbs(rhs_sum.data(), high, rhs, low));
+			std::vector<std::uint64_t> middle(2 * (high + 1));
+			karatsuba_multiply(lhs_sum.data(), rhs_sum.data(), high + 1, middle.data());
+			subtract_limbs(middle.data(), middle.size(), product, 2 * low);
+			subtract_limbs(middle.data(), middle.size(), product + 2 * low, 2 * high);
+
+			// The middle term is below 2 B^size, so its top limb is zero.
+			std::size_t middle_size = middle.size();
+			while (middle_size > 0 && middle[middle_size - 1] == 0) {
+				middle_size--;
+			}
+			add_limbs(product + low, 2 * size - low, middle.data(), middle_size);
+		}
+
+		// product[0, lhs_size + rhs_size) = lhs * rhs. Unbalanced operands are
+		// cut into square blocks of the shorter length.
+		void multiply_limbs(const std::uint64_t *lhs, std::size_t lhs_size, const std::uint64_t *rhs, std::size_t rhs_size, std::uint64_t *product) {
+			if (lhs_size < rhs_size) {
+				std::swap(lhs, rhs);
+				std::swap(lhs_size, rhs_size);
+			}
+			if (rhs_size < big_uint::karatsuba_threshold) {
+				schoolbook_multiply(lhs, lhs_size, rhs, rhs_size, product);
+				return;
+			}
+			if (lhs_size == rhs_size) {
+				karatsuba_multiply(lhs, rhs, lhs_size, product);
+				return;
+			}
+			std::fill(product, product + lhs_size + rhs_size, 0);
+			std::vector<std::uint64_t> block(2 * rhs_size);
+			for (std::size_t offset = 0; offset < lhs_size; offset += rhs_size) {
+				const std::size_t block_size = std::min(rhs_size, lhs_size - offset);
+				multiply_limbs(lhs + offset, block_size, rhs, rhs_size, block.data());
+				add_limbs(product + offset, lhs_size + rhs_size - offset, block.data(), block_size + rhs_size);
+			}
+		}
+
+		// A single-limb divisor with its reciprocal precomputed, so dividing a
+		// two-limb value takes two multiplications and no hardware divide
+		// (Moller and Granlund, "Improved division by invariant integers").
+		class limb_divisor {
+		public:
+			explicit limb_divisor(const std::uint64_t divisor)
+				: shift_(std::countl_zero(divisor)),
+				  normalized_(divisor << shift_),
+				  reciprocal_(static_cast<std::uint64_t>(~uint128_t {0} / normalized_)) {}
+
+			// Divides limbs in place, most significant last, and returns the remainder.
+			std::uint64_t divide(std::uint64_t *limbs, const std::size_t size) const {
+				if (size == 0) {
+					return 0;
+				}
+				// Shifting the dividend by the divisor's normalization keeps every
+				// partial remainder below normalized_.
+				std::uint64_t remainder = shift_ == 0 ? 0 : limbs[size - 1] >> (64 - shift_);
+				for (std::size_t i = size; i-- > 0;) {
+					const std::uint64_t below = i > 0 && shift_ != 0 ? limbs[i - 1] >> (64 - shift_) : 0;
+					limbs[i] = divide_two_limbs(remainder, (limbs[i] << shift_) | below, remainder);
+				}
+				return remainder >> shift_;
+			}
+
+			// (high, low) / divisor for a divisor with its top bit set and
+			// high < divisor; the remainder goes to remainder.
+			std::uint64_t divide_two_limbs(const std::uint64_t high, const std::uint64_t low, std::uint64_t &remainder) const {
+				const uint128_t estimate = static_cast<uint128_t>(reciprocal_) * high + ((static_cast<uint128_t>(high) << 64) | low);
+				std::uint64_t quotient = static_cast<std::uint64_t>(estimate >> 64) + 1;
+				remainder = low - quotient * normalized_;
+				// The first correction fires about half the time, so it is a mask
+				// rather than a branch; the second is rare.
+				const std::uint64_t overshoot = 0 - static_cast<std::uint64_t>(remainder > static_cast<std::uint64_t>(estimate));
+				quotient += overshoot;
+				remainder += overshoot & normalized_;
+				if (remainder >= normalized_) [[unlikely]] {
+					quotient++;
+					remainder -= normalized_;
+				}
+				return quotient;
+			}
+
+		private:
+			int shift_;
+			std::uint64_t normalized_;
+			std::uint64_t reciprocal_;
+		};
+
+		constexpr std::size_t digits_per_limb = 19;
+		constexpr std::uint64_t limb_digit_divisor = 10000000000000000000ULL;
+	}
+
+	big_uint::big_uint(const uint128_t value) {
+		limbs_.push_back(static_cast<std::uint64_t>(value));
+		limbs_.push_back(static_cast<std::uint64_t>(value >> 64));
+		trim();
+	}
+
+	big_uint big_uint::from_string(const std::string_view digits) {
+		if (digits.empty()) {
+			throw std::invalid_argument("Expected decimal digits.");
+		}
+		// Chunks of 19 digits, least significant first; only the last one can
+		// be shorter.
+		std::vector<big_uint> level {};
+		for (std::size_t end = digits.size(); end > 0;) {
+			const std::size_t begin = end > digits_per_limb ? end - digits_per_limb : 0;
+			std::uint64_t value = 0;
+			for (const char c : digits.substr(begin, end - begin)) {
+				if (c < '0' || c > '9') {
+					throw std::invalid_argument("Expected decimal digits.");
+				}
+				value = value * 10 + static_cast<std::uint64_t>(c - '0');
+			}
+			level.emplace_back(value);
+			end = begin;
+		}
+
+		// Every entry but the last of a level spans exactly as many digits as
+		// scale has zeros, so pairs combine as high * scale + low.
+		big_uint scale(limb_digit_divisor);
+		while (level.size() > 1) {
+			std::vector<big_uint> next((level.size() + 1) / 2);
+			for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+				next[i / 2] = level[i + 1] * scale + level[i];
+			}
+			if (level.size() % 2 == 1) {
+				next.back() = std::move(level.back());
+			}
+			level = std::move(next);
+			if (level.size() > 1) {
+				scale *= scale;
+			}
+		}
+		return std::move(level.front());
+	}
+
+	std::size_t big_uint::bit_width() const {
+		return limbs_.empty() ? 0 : 64 * (limbs_.size() - 1) + std::bit_width(limbs_.back());
+	}
+
+	std::uint64_t big_uint::to_u64() const {
+		if (limbs_.size() > 1) {
+			throw std::overflow_error("Value does not fit in 64 bits.");
+		}
+		return limbs_.empty() ? 0 : limbs_[0];
+	}
+
+	std::string big_uint::to_string() const {
+		if (limbs_.empty()) {
+			return "0";
+		}
+		// Each sweep divides by 10^19 four times over, peeling off four chunks
+		// of 19 digits, least significant first. The four running remainders
+		// are independent dependency chains, so their multiplications overlap.
+		// Digits are written from the back of a zero-filled buffer so inner
+		// chunks keep their leading zeros.
+		constexpr std::size_t chunks_per_sweep = 4;
+		const limb_divisor divisor(limb_digit_divisor);
+		detail::limb_buffer rest = limbs_;
+		std::size_t size = rest.size();
+		std::string digits((size * 64 / 63 + chunks_per_sweep) * digits_per_limb, '0');
+		std::size_t first = digits.size();
+		while (size > 0) {
+			std::array<std::uint64_t, chunks_per_sweep> chunks {};
+			for (std::size_t i = size; i-- > 0;) {
+				std::uint64_t limb = rest[i];
+				for (std::uint64_t &chunk : chunks) {
+					limb = divisor.divide_two_limbs(chunk, limb, chunk);
+				}
+				rest[i] = limb;
+			}
+			while (size > 0 && rest[size - 1] == 0) {
+				size--;
+			}
+			std::size_t written = chunks_per_sweep;
+			while (size == 0 && written > 1 && chunks[written - 1] == 0) {
+				written--;
+			}
+			for (std::size_t c = 0; c < written; c++) {
+				const std::size_t chunk_end = first;
+				for (std::uint64_t chunk = chunks[c]; chunk != 0; chunk /= 10) {
+					digits[--first] = static_cast<char>('0' + chunk % 10);
+				}
+				if (size > 0 || c + 1 < written) {
+					first = chunk_end - digits_per_limb;
+				}
+			}
+		}
+		return digits.substr(first);
+	}
+
+	std::uint64_t big_uint::divide_by(const std::uint64_t divisor) {
+		if (divisor == 0) {
+			throw std::domain_error("big_uint division by zero.");
+		}
+		const std::uint64_t remainder = limb_divisor(divisor).divide(limbs_.data(), limbs_.size());
+		trim();
+		return remainder;
+	}
+
+	big_uint &big_uint::operator+=(const big_uint &other) {
+		if (limbs_.size() < other.limbs_.size()) {
+			limbs_.resize(other.limbs_.size());
+		}
+		if (add_limbs(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size()) != 0) {
+			limbs_.push_back(1);
+		}
+		return *this;
+	}
+
+	big_uint &big_uint::operator-=(const big_uint &other) {
+		if (*this < other) {
+			throw std::underflow_error("big_uint subtraction would go below zero.");
+		}
+		subtract_limbs(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size());
+		trim();
+		return *this;
+	}
+
+	big_uint operator*(const big_uint &lhs, const big_uint &rhs) {
+		big_uint product {};
+		if (lhs.is_zero() || rhs.is_zero()) {
+			return product;
+		}
+		const std::size_t size = lhs.limbs_.size() + rhs.limbs_.size();
+		// Small products go through a stack buffer, so a result that fits
+		// inline never allocates.
+		if (size <= small_product_limbs) {
+			std::array<std::uint64_t, small_product_limbs> scratch {};
+			multiply_limbs(lhs.limbs_.data(), lhs.limbs_.size(), rhs.limbs_.data(), rhs.limbs_.size(), scratch.data());
+			const std::size_t used = scratch[size - 1] == 0 ? size - 1 : size;
+			product.limbs_.assign(scratch.data(), used);
+			return product;
+		}
+		product.limbs_.resize(size);
+		multiply_limbs(lhs.limbs_.data(), lhs.limbs_.size(), rhs.limbs_.data(), rhs.limbs_.size(), product.limbs_.data());
+		product.trim();
+		return product;
+	}
+
+	big_uint &big_uint::operator*=(const big_uint &other) {
+		*this = *this * other;
+		return *this;
+	}
+
+	std::strong_ordering operator<=>(const big_uint &lhs, const big_uint &rhs) {
+		if (lhs.limbs_.size() != rhs.limbs_.size()) {
+			return lhs.limbs_.size() <=> rhs.limbs_.size();
+		}
+		for (std::size_t i = lhs.limbs_.size(); i-- > 0;) {
+			if (lhs.limbs_[i] != rhs.limbs_[i]) {
+				return lhs.limbs_[i] <=> rhs.limbs_[i];
+			}
+		}
+		return std::strong_ordering::equal;
+	}
+
+	void big_uint::trim() {
+		while (!limbs_.empty() && limbs_.back() == 0) {
+			limbs_.pop_back();
+		}
+		limbs_.shrink_to_inline();
+	}
+
+	big_uint product_tree(const std::span<const std::uint64_t> factors) {
+		std::vector<big_uint> level {};
+		std::uint64_t packed = 1;
+		for (const std::uint64_t factor : factors) {
+			if (factor == 0) {
+				return {};
+			}
+			if (packed > std::numeric_limits<std::uint64_t>::max() / factor) {
+				level.emplace_back(packed);
+				packed = 1;
+			}
+			packed *= factor;
+		}
+		level.emplace_back(packed);
+
+		while (level.size() > 1) {
+			std::vector<big_uint> next((level.size() + 1) / 2);
+			for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+				next[i / 2] = level[i] * level[i + 1];
+			}
+			if (level.size() % 2 == 1) {
+				next.back() = std::move(level.back());
+			}
+			level = std::move(next);
+		}
+		return std::move(level.front());
+	}
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include "precompile_header.h"
+#include "int128.h"
+
+namespace utils {
+
+	namespace detail {
+		// Limb storage that keeps up to inline_capacity limbs (256 bits) inside
+		// the object and only allocates beyond that.
+		class limb_buffer {
+		public:
+			static constexpr std::size_t inline_capacity = 4;
+
+			limb_buffer() = default;
+			limb_buffer(const limb_buffer &other);
+			limb_buffer(limb_buffer &&other) noexcept;
+			limb_buffer &operator=(const limb_buffer &other);
+			limb_buffer &operator=(limb_buffer &&other) noexcept;
+			~limb_buffer();
+
+			[[nodiscard]] std::size_t size() const { return size_; }
+			[[nodiscard]] bool empty() const { return size_ == 0; }
+			[[nodiscard]] bool is_inline() const { return capacity_ == inline_capacity; }
+
+			[[nodiscard]] std::uint64_t *data() { return is_inline() ? inline_.data() : heap_; }
+			[[nodiscard]] const std::uint64_t *data() const { return is_inline() ? inline_.data() : heap_; }
+			[[nodiscard]] std::uint64_t *begin() { return data(); }
+			[[nodiscard]] std::uint64_t *end() { return data() + size_; }
+			[[nodiscard]] const std::uint64_t *begin() const { return data(); }
+			[[nodiscard]] const std::uint64_t *end() const { return data() + size_; }
+
+			std::uint64_t &operator[](const std::size_t i) { return data()[i]; }
+			const std::uint64_t &operator[](const std::size_t i) const { return data()[i]; }
+			[[nodiscard]] std::uint64_t back() const { return data()[size_ - 1]; }
+
+			void push_back(std::uint64_t limb);
+			void pop_back() { size_--; }
+			// New limbs are zero.
+			void resize(std::size_t size);
+			void reserve(std::size_t capacity);
+			// Replaces the contents with limbs[0, count).
+			void assign(const std::uint64_t *limbs, std::size_t count);
+			// Moves heap limbs back inline once they fit again.
+			void shrink_to_inline();
+
+			friend bool operator==(const limb_buffer &lhs, const limb_buffer &rhs) {
+				return std::ranges::equal(lhs, rhs);
+			}
+
+		private:
+			std::size_t size_ = 0;
+			std::size_t capacity_ = inline_capacity;
+			union {
+				std::array<std::uint64_t, inline_capacity> inline_ {};
+				std::uint64_t *heap_;
+			};
+		};
+	}
+
+	// Arbitrary-precision unsigned integer stored as little-endian 64-bit
+	// limbs without leading zero limbs, so zero has no limbs at all. Values
+	// up to 256 bits live inline without touching the heap. Multiplication is
+	// schoolbook below karatsuba_threshold limbs and Karatsuba above it.
+	class big_uint {
+	public:
+		static constexpr std::size_t karatsuba_threshold = 32;
+
+		big_uint() = default;
+
+		// Throws std::domain_error for a negative value.
+		template<std::integral Integer>
+			requires (sizeof(Integer) <= 8)
+		big_uint(const Integer value) {
+			if constexpr (std::is_signed_v<Integer>) {
+				if (value < 0) {
+					throw std::domain_error("big_uint cannot hold a negative value.");
+				}
+			}
+			if (value != 0) {
+				limbs_.push_back(static_cast<std::uint64_t>(value));
+			}
+		}
+
+		big_uint(uint128_t value);
+
+		// Decimal digits only; throws std::invalid_argument otherwise. Chunks of
+		// 19 digits are combined pairwise with squared powers of 10^19, so long
+		// inputs ride on Karatsuba.
+		static big_uint from_string(std::string_view digits);
+
+		[[nodiscard]] bool is_zero() const { return limbs_.empty(); }
+
+		[[nodiscard]] std::size_t bit_width() const;
+
+		[[nodiscard]] std::span<const std::uint64_t> limbs() const { return {limbs_.data(), limbs_.size()}; }
+
+		// Throws std::overflow_error when the value needs more than 64 bits.
+		[[nodiscard]] std::uint64_t to_u64() const;
+
+		// Peels four chunks of 19 digits per sweep, dividing by 10^19 through a
+		// precomputed reciprocal instead of a hardware divide per limb.
+		[[nodiscard]] std::string to_string() const;
+
+		// Divides in place and returns the remainder. Throws std::domain_error
+		// for a zero divisor.
+		std::uint64_t divide_by(std::uint64_t divisor);
+
+		big_uint &operator+=(const big_uint &other);
+
+		// Throws std::underflow_error when other is larger.
+		big_uint &operator-=(const big_uint &other);
+
+		big_uint &operator*=(const big_uint &other);
+
+		friend big_uint operator+(big_uint lhs, const big_uint &rhs) { return lhs += rhs; }
+		friend big_uint operator-(big_uint lhs, const big_uint &rhs) { return lhs -= rhs; }
+		friend big_uint operator*(const big_uint &lhs, const big_uint &rhs);
+		friend big_uint operator/(big_uint lhs, const std::uint64_t rhs) {
+			lhs.divide_by(rhs);
+			return lhs;
+		}
+		friend std::uint64_t operator%(big_uint lhs, const std::uint64_t rhs) { return lhs.divide_by(rhs); }
+
+		friend bool operator==(const big_uint &lhs, const big_uint &rhs) = default;
+		friend std::strong_ordering operator<=>(const big_uint &lhs, const big_uint &rhs);
+
+		friend std::ostream &operator<<(std::ostream &os, const big_uint &value) { return os << value.to_string(); }
+
+	private:
+		void trim();
+
+		detail::limb_buffer limbs_ {};
+	};
+
+	// Product of all factors, 1 for none. Factors are first packed into as few
+	// 64-bit words as fit, then multiplied pairwise up a balanced tree, so each
+	// level multiplies operands of similar size instead of growing one
+	// accumulator a limb at a time.
+	big_uint product_tree(std::span<const std::uint64_t> factors);
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "precompile_header.h"
+#include "int128.h"
+
+namespace utils {
+
+	// Unsigned types the decimal digit helpers take, including the 128-bit
+	// extension that std::unsigned_integral only accepts in GNU mode.
+	template<typename T>
+	concept digit_integer = (std::unsigned_integral<T> && !std::same_as<T, bool>) || std::same_as<T, uint128_t>;
+
+	namespace detail {
+		template<digit_integer T>
+		constexpr int digit_bit_width(const T n) {
+			if constexpr (sizeof(T) > 8) {
+				const auto high = static_cast<std::uint64_t>(n >> 64);
+				return high != 0 ? 64 + std::bit_width(high) : std::bit_width(static_cast<std::uint64_t>(n));
+			} else {
+				return std::bit_width(n);
+			}
+		}
+
+		// floor(bits * log10(2)) for every bit width of T, as 1233 / 4096
+		// rounds log10(2) close enough up to 128 bits.
+		constexpr int digits_below_bit_width(const int bits) {
+			return (bits * 1233) >> 12;
+		}
+
+		// 10^0 up to the largest power that can share a bit width with a value
+		// of T.
+		template<digit_integer T>
+		inline constexpr auto powers_of_10 = [] {
+			std::array<T, digits_below_bit_width(8 * sizeof(T)) + 1> powers {};
+			T power = 1;
+			for (T &entry : powers) {
+				entry = power;
+				power *= 10;
+			}
+			return powers;
+		}();
+	}
+
+	// Number of decimal digits in n, 1 for zero. The bit width picks the only
+	// two candidates and one table lookup settles between them, so no
+	// division runs.
+	template<digit_integer T>
+	constexpr int digit_count(const T n) {
+		const int guess = detail::digits_below_bit_width(detail::digit_bit_width(n));
+		return std::max(1, guess + (n >= detail::powers_of_10<T>[guess] ? 1 : 0));
+	}
+
+	// n with its decimal digits in reverse order; trailing zeros are dropped,
+	// so 1200 gives 21. The result wraps if it does not fit in T.
+	template<digit_integer T>
+	constexpr T reverse_digits(T n) {
+		T reversed = 0;
+		while (n != 0) {
+			reversed = reversed * 10 + n % 10;
+			n /= 10;
+		}
+		return reversed;
+	}
+
+	// Whether n reads the same in both directions. Only the low half of the
+	// digits is reversed, so this cannot overflow.
+	template<digit_integer T>
+	constexpr bool is_palindrome(T n) {
+		if (n != 0 && n % 10 == 0) {
+			return false;
+		}
+		T reversed_half = 0;
+		while (n > reversed_half) {
+			reversed_half = reversed_half * 10 + n % 10;
+			n /= 10;
+		}
+		return n == reversed_half || n == reversed_half / 10;
+	}
+
+	template<digit_integer T>
+	constexpr int digit_sum(T n) {
+		int sum = 0;
+		while (n != 0) {
+			sum += static_cast<int>(n % 10);
+			n /= 10;
+		}
+		return sum;
+	}
+
+	// The decimal digits of a value as a range of ints, least significant
+	// first. Zero has the single digit 0.
+	//
+	//     for (int digit : digit_view(1234u)) ...  // 4, 3, 2, 1
+	template<digit_integer T>
+	class digit_view : public std::ranges::view_interface<digit_view<T>> {
+	public:
+		class iterator {
+		public:
+			using value_type = int;
+			using difference_type = std::ptrdiff_t;
+
+			constexpr iterator() = default;
+			constexpr iterator(const T rest, const int remaining) : rest_(rest), remaining_(remaining) {}
+
+			constexpr int operator*() const { return static_cast<int>(rest_ % 10); }
+
+			constexpr iterator &operator++() {
+				rest_ /= 10;
+				remaining_--;
+				return *this;
+			}
+
+			constexpr iterator operator++(int) {
+				iterator previous = *this;
+				++*this;
+				return previous;
+			}
+
+			friend constexpr bool operator==(const iterator &lhs, const iterator &rhs) { return lhs.remaining_ == rhs.remaining_; }
+			friend constexpr bool operator==(const iterator &it, std::default_sentinel_t) { return it.remaining_ == 0; }
+
+		private:
+			T rest_ {};
+			int remaining_ {};
+		};
+
+		constexpr digit_view() = default;
+		constexpr explicit digit_view(const T value) : value_(value) {}
+
+		constexpr iterator begin() const { return {value_, digit_count(value_)}; }
+		constexpr std::default_sentinel_t end() const { return {}; }
+		constexpr std::size_t size() const { return static_cast<std::size_t>(digit_count(value_)); }
+
+	private:
+		T value_ {};
+	};
+}
+
+namespace std::ranges {
+	template<typename T>
+	inline constexpr bool enable_borrowed_range<utils::digit_view<T>> = true;
+}
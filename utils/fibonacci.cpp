@@ -0,0 +1,130 @@
+#include "fibonacci.h"
+#include "modint.h"
+#include "prime_utils.h"
+
+namespace utils {
+	template<fibonacci_value T>
+	T fibonacci(const std::uint64_t n) {
+		if (n > max_fibonacci_index<T>()) {
+			throw std::overflow_error("F(" + std::to_string(n) + ") does not fit in the result type.");
+		}
+		// (current, next) = (F(k), F(k+1)) for k the bits of n read so far.
+		// Fixed-width types may wrap while computing F(n+1) on the last step,
+		// which leaves F(n) itself exact.
+		T current = 0;
+		T next = 1;
+		for (int bit = std::bit_width(n) - 1; bit >= 0; bit--) {
+			const T doubled = current * (next + next - current);
+			const T doubled_next = current * current + next * next;
+			if ((n >> bit) & 1) {
+				current = doubled_next;
+				next = doubled + doubled_next;
+			} else {
+				current = doubled;
+				next = doubled_next;
+			}
+		}
+		return current;
+	}
+
+	std::uint64_t fibonacci_mod(const std::uint64_t n, const std::uint64_t m) {
+		if (m == 0) {
+			throw std::invalid_argument("Modulus must be positive.");
+		}
+		const dynamic_reduction arithmetic(m);
+		std::uint64_t current = 0;
+		std::uint64_t next = arithmetic.one();
+		for (int bit = std::bit_width(n) - 1; bit >= 0; bit--) {
+			const std::uint64_t doubled = arithmetic.mul(current, arithmetic.sub(arithmetic.add(next, next), current));
+			const std::uint64_t doubled_next = arithmetic.add(arithmetic.mul(current, current), arithmetic.mul(next, next));
+			if ((n >> bit) & 1) {
+				current = doubled_next;
+				next = arithmetic.add(doubled, doubled_next);
+			} else {
+				current = doubled;
+				next = doubled_next;
+			}
+		}
+		return arithmetic.from_form(current);
+	}
+
+	namespace {
+		std::uint64_t checked_period(const uint128_t period) {
+			if (period >> 64 != 0) {
+				throw std::overflow_error("The Pisano period does not fit in 64 bits.");
+			}
+			return static_cast<std::uint64_t>(period);
+		}
+
+		std::uint64_t prime_pisano_period(const std::uint64_t p) {
+			if (p == 2) {
+				return 3;
+			}
+			if (p == 5) {
+				return 20;
+			}
+			// By quadratic reciprocity pi(p) divides p - 1 when p = +-1 mod 10
+			// and 2(p + 1) otherwise. Strip prime factors from that bound while
+			// the sequence still returns to (0, 1).
+			std::uint64_t period = p % 10 == 1 || p % 10 == 9 ? p - 1 : checked_period(2 * static_cast<uint128_t>(p + 1));
+			for (const auto &[q, exponent] : factorize_u64(period)) {
+				for (int i = 0; i < exponent; i++) {
+					const std::uint64_t shorter = period / q;
+					if (fibonacci_mod(shorter, p) != 0 || fibonacci_mod(shorter + 1, p) != 1) {
+						break;
+					}
+					period = shorter;
+				}
+			}
+			return period;
+		}
+	}
+
+	std::uint64_t pisano_period(const std::uint64_t m) {
+		if (m == 0) {
+			throw std::invalid_argument("Modulus must be positive.");
+		}
+		static std::map<std::uint64_t, std::uint64_t> cache {};
+		static std::mutex cache_mtx;
+		{
+			std::lock_guard lock(cache_mtx);
+			if (const auto cached = cache.find(m); cached != cache.end()) {
+				return cached->second;
+			}
+		}
+
+		uint128_t period = 1;
+		for (const auto &[p, exponent] : factorize_u64(m)) {
+			uint128_t prime_power_period = prime_pisano_period(p);
+			for (int i = 1; i < exponent; i++) {
+				prime_power_period *= p;
+			}
+			const uint128_t common = std::gcd(static_cast<std::uint64_t>(period), checked_period(prime_power_period));
+			period = period / common * prime_power_period;
+			checked_period(period);
+		}
+
+		std::lock_guard lock(cache_mtx);
+		cache.emplace(m, static_cast<std::uint64_t>(period));
+		return static_cast<std::uint64_t>(period);
+	}
+
+	std::uint64_t fibonacci_mod_periodic(const uint128_t n, const std::uint64_t m) {
+		return fibonacci_mod(static_cast<std::uint64_t>(n % pisano_period(m)), m);
+	}
+
+	template<fibonacci_value T>
+	T fibonacci_prefix_sum(const std::uint64_t n) {
+		if (n > max_fibonacci_index<T>() - 2) {
+			throw std::overflow_error("The sum of F(0) to F(" + std::to_string(n) + ") does not fit in the result type.");
+		}
+		return fibonacci<T>(n + 2) - T {1};
+	}
+
+	template std::uint64_t fibonacci<std::uint64_t>(std::uint64_t);
+	template uint128_t fibonacci<uint128_t>(std::uint64_t);
+	template big_uint fibonacci<big_uint>(std::uint64_t);
+	template std::uint64_t fibonacci_prefix_sum<std::uint64_t>(std::uint64_t);
+	template uint128_t fibonacci_prefix_sum<uint128_t>(std::uint64_t);
+	template big_uint fibonacci_prefix_sum<big_uint>(std::uint64_t);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "precompile_header.h"
+#include "int128.h"
+#include "big_uint.h"
+
+namespace utils {
+
+	// Result types the Fibonacci functions are instantiated for.
+	template<typename T>
+	concept fibonacci_value = std::same_as<T, std::uint64_t> || std::same_as<T, uint128_t> || std::same_as<T, big_uint>;
+
+	// Largest n with F(n) representable in T: 93 for 64 bits, 186 for 128.
+	template<typename T>
+	constexpr std::uint64_t max_fibonacci_index() {
+		if constexpr (std::same_as<T, big_uint>) {
+			return std::numeric_limits<std::uint64_t>::max();
+		} else {
+			T previous = 0;
+			T current = 1;
+			std::uint64_t n = 1;
+			while (current <= static_cast<T>(~T {0}) - previous) {
+				current = std::exchange(previous, current) + current;
+				n++;
+			}
+			return n;
+		}
+	}
+
+	// F(n) with F(0) = 0, F(1) = 1, by fast doubling:
+	//     F(2k) = F(k) * (2 F(k+1) - F(k)),  F(2k+1) = F(k)^2 + F(k+1)^2,
+	// so O(log n) multiplications. Throws std::overflow_error when F(n) does
+	// not fit in T.
+	template<fibonacci_value T>
+	T fibonacci(std::uint64_t n);
+
+	// F(n) mod m by fast doubling in Montgomery or Barrett arithmetic, for any
+	// n and m. Throws std::invalid_argument for m == 0.
+	std::uint64_t fibonacci_mod(std::uint64_t n, std::uint64_t m);
+
+	// Pisano period pi(m), the period of F(n) mod m. Built from the prime
+	// factorization of m: pi(p) is the smallest divisor d of p - 1 or of
+	// 2(p + 1) with F(d) = 0 and F(d + 1) = 1 mod p, pi(p^e) = p^(e-1) pi(p),
+	// and pi(m) is the lcm over the prime powers. Results are cached per
+	// modulus, so repeated calls are a lookup. Throws std::invalid_argument
+	// for m == 0 and std::overflow_error if the period needs more than 64 bits.
+	std::uint64_t pisano_period(std::uint64_t m);
+
+	// F(n) mod m for 128-bit indices, reducing n modulo the cached Pisano
+	// period first.
+	std::uint64_t fibonacci_mod_periodic(uint128_t n, std::uint64_t m);
+
+	// F(0) + F(1) + ... + F(n), which is F(n + 2) - 1.
+	template<fibonacci_value T>
+	T fibonacci_prefix_sum(std::uint64_t n);
+
+	// Sum of the even Fibonacci numbers that do not exceed limit. Every third
+	// term is even, and they follow E(k) = 4 E(k-1) + E(k-2), so only those
+	// O(log limit) terms are visited: a 1e30 limit takes about 50 steps.
+	// constexpr for the fixed-width types.
+	template<fibonacci_value T>
+	constexpr T even_fibonacci_sum(const T &limit) {
+		// E(0) = F(0) = 0 and E(1) = F(3) = 2.
+		T previous = 0;
+		T current = 2;
+		T sum = 0;
+		while (current <= limit) {
+			if constexpr (!std::same_as<T, big_uint>) {
+				if (sum > static_cast<T>(~T {0}) - current) {
+					throw std::overflow_error("The even Fibonacci sum does not fit in the result type.");
+				}
+			}
+			sum += current;
+			if constexpr (!std::same_as<T, big_uint>) {
+				// Stop before 4 E(k) + E(k-1) could wrap around past the limit.
+				if (current > (limit - previous) / 4) {
+					break;
+				}
+			}
+			previous = std::exchange(current, current * T {4} + previous);
+		}
+		return sum;
+	}
+}
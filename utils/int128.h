@@ -0,0 +1,10 @@
+#pragma once
+#include "precompile_header.h"
+
+namespace utils {
+
+	// GCC and Clang's 128-bit unsigned integer, for widening 64-bit
+	// products and sums.
+	using uint128_t = unsigned __int128;
+
+}
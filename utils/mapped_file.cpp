@@ -0,0 +1,169 @@
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+#if defined(_WIN32)
+	mapped_file::mapped_file(const std::filesystem::path &path) {
+		const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+		                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("Could not open " + path.string() + " for mapping.");
+		}
+		LARGE_INTEGER size {};
+		GetFileSizeEx(file, &size);
+		size_ = static_cast<std::size_t>(size.QuadPart);
+		if (size_ == 0) {
+			CloseHandle(file);
+			return;
+		}
+
+		// The mapping object keeps the file alive, so the file handle can go now.
+		mapping_handle_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping_handle_ == nullptr) {
+			throw std::runtime_error("Could not map " + path.string() + ".");
+		}
+		data_ = static_cast<std::byte *>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+		if (data_ == nullptr) {
+			CloseHandle(mapping_handle_);
+			mapping_handle_ = nullptr;
+			throw std::runtime_error("Could not map " + path.string() + ".");
+		}
+	}
+
+	mapped_file mapped_file::create(const std::filesystem::path &path, const std::size_t size) {
+		const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+		                                CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("Could not create " + path.string() + " for mapping.");
+		}
+		mapped_file result {};
+		if (size == 0) {
+			CloseHandle(file);
+			return result;
+		}
+
+		// Mapping past the end grows the file to size, filled with zeros.
+		const auto large_size = static_cast<std::uint64_t>(size);
+		result.mapping_handle_ = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(large_size >> 32),
+		                                            static_cast<DWORD>(large_size), nullptr);
+		CloseHandle(file);
+		if (result.mapping_handle_ == nullptr) {
+			throw std::runtime_error("Could not map " + path.string() + ".");
+		}
+		result.data_ = static_cast<std::byte *>(MapViewOfFile(result.mapping_handle_, FILE_MAP_WRITE, 0, 0, 0));
+		if (result.data_ == nullptr) {
+			throw std::runtime_error("Could not map " + path.string() + ".");
+		}
+		result.size_ = size;
+		result.writable_ = true;
+		return result;
+	}
+
+	void mapped_file::close() {
+		if (data_ != nullptr) {
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_handle_ != nullptr) {
+			CloseHandle(mapping_handle_);
+		}
+		data_ = nullptr;
+		mapping_handle_ = nullptr;
+		size_ = 0;
+		writable_ = false;
+	}
+#else
+	mapped_file::mapped_file(const std::filesystem::path &path) {
+		const int file = ::open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			throw std::runtime_error("Could not open " + path.string() + " for mapping.");
+		}
+		struct stat status {};
+		if (::fstat(file, &status) != 0) {
+			::close(file);
+			throw std::runtime_error("Could not stat " + path.string() + ".");
+		}
+		size_ = static_cast<std::size_t>(status.st_size);
+		if (size_ == 0) {
+			::close(file);
+			return;
+		}
+
+		// The mapping keeps its own reference to the file, so the descriptor can go now.
+		void *data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0);
+		::close(file);
+		if (data == MAP_FAILED) {
+			size_ = 0;
+			throw std::runtime_error("Could not map " + path.string() + ".");
+		}
+		data_ = static_cast<std::byte *>(data);
+	}
+
+	mapped_file mapped_file::create(const std::filesystem::path &path, const std::size_t size) {
+		const int file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (file < 0) {
+			throw std::runtime_error("Could not create " + path.string() + " for mapping.");
+		}
+		mapped_file result {};
+		if (size == 0) {
+			::close(file);
+			return result;
+		}
+		// Extending with ftruncate leaves a sparse file of zeros.
+		if (::ftruncate(file, static_cast<off_t>(size)) != 0) {
+			::close(file);
+			throw std::runtime_error("Could not resize " + path.string() + ".");
+		}
+
+		void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		::close(file);
+		if (data == MAP_FAILED) {
+			throw std::runtime_error("Could not map " + path.string() + ".");
+		}
+		result.data_ = static_cast<std::byte *>(data);
+		result.size_ = size;
+		result.writable_ = true;
+		return result;
+	}
+
+	void mapped_file::close() {
+		if (data_ != nullptr) {
+			::munmap(data_, size_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+		writable_ = false;
+	}
+#endif
+
+	mapped_file::~mapped_file() {
+		close();
+	}
+
+	mapped_file::mapped_file(mapped_file &&other) noexcept {
+		*this = std::move(other);
+	}
+
+	mapped_file &mapped_file::operator=(mapped_file &&other) noexcept {
+		if (this != &other) {
+			close();
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			writable_ = std::exchange(other.writable_, false);
+#if defined(_WIN32)
+			mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+		}
+		return *this;
+	}
+}
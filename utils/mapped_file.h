@@ -0,0 +1,50 @@
+#pragma once
+#include "precompile_header.h"
+
+namespace utils {
+
+	// Memory mapping of a whole file, read-only unless made by create.
+	// Processes that map the same file share its pages through the OS page
+	// cache, so opening a large table costs a system call rather than a read.
+	// Uses mmap on POSIX and file mapping objects on Windows.
+	class mapped_file {
+	public:
+		mapped_file() = default;
+
+		// Throws std::runtime_error when the file cannot be opened or mapped.
+		explicit mapped_file(const std::filesystem::path &path);
+
+		// Create or truncate path, fill it with size zero bytes and map it
+		// read-write. Writes reach the file as the OS pages them out, so the
+		// mapping can be larger than physical memory.
+		static mapped_file create(const std::filesystem::path &path, std::size_t size);
+
+		~mapped_file();
+
+		mapped_file(const mapped_file &) = delete;
+		mapped_file &operator=(const mapped_file &) = delete;
+		mapped_file(mapped_file &&other) noexcept;
+		mapped_file &operator=(mapped_file &&other) noexcept;
+
+		[[nodiscard]] bool is_open() const { return data_ != nullptr; }
+		[[nodiscard]] std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+		// Throws std::logic_error on a read-only mapping.
+		[[nodiscard]] std::span<std::byte> writable_bytes() const {
+			if (!writable_ && size_ != 0) {
+				throw std::logic_error("The file is mapped read-only.");
+			}
+			return {data_, size_};
+		}
+
+	private:
+		void close();
+
+		std::byte *data_ {nullptr};
+		std::size_t size_ {0};
+		bool writable_ {false};
+#if defined(_WIN32)
+		void *mapping_handle_ {nullptr};
+#endif
+	};
+}
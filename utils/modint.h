@@ -0,0 +1,186 @@
+#pragma once
+#include "precompile_header.h"
+#include "montgomery.h"
+
+namespace utils {
+
+	// Compile-time modulus for modint: Montgomery form when Mod is odd,
+	// Barrett reduction when it is even.
+	template<std::uint64_t Mod>
+		requires (Mod > 0)
+	struct static_modulus {
+		using arithmetic_type = std::conditional_t<Mod % 2 == 1, montgomery<std::uint64_t>,
+			std::conditional_t<(Mod >> 32) == 0, barrett<std::uint32_t>, barrett<std::uint64_t>>>;
+
+		static constexpr arithmetic_type arithmetic {static_cast<typename arithmetic_type::value_type>(Mod)};
+	};
+
+	// Runtime modulus picking Montgomery or Barrett reduction when it is set.
+	// Interface matches montgomery<std::uint64_t>.
+	class dynamic_reduction {
+	public:
+		using value_type = std::uint64_t;
+
+		explicit dynamic_reduction(const std::uint64_t mod)
+			: odd_(mod % 2 == 1), montgomery_(odd_ ? mod : 1), barrett_(mod) {}
+
+		[[nodiscard]] std::uint64_t mod() const { return barrett_.mod(); }
+		[[nodiscard]] std::uint64_t to_form(const std::uint64_t x) const { return odd_ ? montgomery_.to_form(x) : barrett_.to_form(x); }
+		[[nodiscard]] std::uint64_t from_form(const std::uint64_t x) const { return odd_ ? montgomery_.from_form(x) : x; }
+		[[nodiscard]] std::uint64_t one() const { return odd_ ? montgomery_.one() : barrett_.one(); }
+
+		[[nodiscard]] std::uint64_t mul(const std::uint64_t a, const std::uint64_t b) const {
+			return odd_ ? montgomery_.mul(a, b) : barrett_.mul(a, b);
+		}
+
+		[[nodiscard]] std::uint64_t add(const std::uint64_t a, const std::uint64_t b) const { return barrett_.add(a, b); }
+		[[nodiscard]] std::uint64_t sub(const std::uint64_t a, const std::uint64_t b) const { return barrett_.sub(a, b); }
+
+	private:
+		bool odd_;
+		montgomery<std::uint64_t> montgomery_;
+		barrett<std::uint64_t> barrett_;
+	};
+
+	// Modulus set at runtime and shared by every dynamic_modint<Id>. Values
+	// made under one modulus are meaningless after set_mod changes it, so
+	// code juggling several moduli gives each its own Id.
+	template<int Id>
+	struct dynamic_modulus {
+		static inline dynamic_reduction arithmetic {1};
+	};
+
+	// Residue class modulo the Context's modulus, stored in the reduction's
+	// internal form so that no operator divides. Everything is constexpr
+	// for compile-time moduli.
+	template<typename Context>
+	class basic_modint {
+	public:
+		constexpr basic_modint() : form_(0) {}
+
+		template<std::integral Integer>
+		constexpr basic_modint(const Integer value) {
+			if constexpr (std::is_signed_v<Integer>) {
+				if (value < 0) {
+					// -(value + 1) + 1 avoids negating the most negative value.
+					const auto magnitude = static_cast<std::uint64_t>(-(value + 1)) + 1;
+					form_ = arithmetic().sub(0, arithmetic().to_form(magnitude));
+					return;
+				}
+			}
+			form_ = arithmetic().to_form(static_cast<std::uint64_t>(value));
+		}
+
+		// Only for dynamic_modint. Invalidates every existing value of this type.
+		static void set_mod(const std::uint64_t mod)
+			requires std::same_as<decltype(Context::arithmetic), dynamic_reduction> {
+			if (mod == 0) {
+				throw std::invalid_argument("Modulus must be positive.");
+			}
+			Context::arithmetic = dynamic_reduction(mod);
+		}
+
+		[[nodiscard]] static constexpr std::uint64_t mod() { return arithmetic().mod(); }
+
+		[[nodiscard]] constexpr std::uint64_t value() const { return arithmetic().from_form(form_); }
+
+		constexpr basic_modint &operator+=(const basic_modint &other) {
+			form_ = arithmetic().add(form_, other.form_);
+			return *this;
+		}
+
+		constexpr basic_modint &operator-=(const basic_modint &other) {
+			form_ = arithmetic().sub(form_, other.form_);
+			return *this;
+		}
+
+		constexpr basic_modint &operator*=(const basic_modint &other) {
+			form_ = arithmetic().mul(form_, other.form_);
+			return *this;
+		}
+
+		// Throws std::invalid_argument when other is not invertible.
+		constexpr basic_modint &operator/=(const basic_modint &other) { return *this *= other.inverse(); }
+
+		[[nodiscard]] constexpr basic_modint operator-() const { return from_form(arithmetic().sub(0, form_)); }
+
+		friend constexpr basic_modint operator+(basic_modint lhs, const basic_modint &rhs) { return lhs += rhs; }
+		friend constexpr basic_modint operator-(basic_modint lhs, const basic_modint &rhs) { return lhs -= rhs; }
+		friend constexpr basic_modint operator*(basic_modint lhs, const basic_modint &rhs) { return lhs *= rhs; }
+		friend constexpr basic_modint operator/(basic_modint lhs, const basic_modint &rhs) { return lhs /= rhs; }
+		friend constexpr bool operator==(const basic_modint &lhs, const basic_modint &rhs) { return lhs.form_ == rhs.form_; }
+
+		[[nodiscard]] constexpr basic_modint pow(std::uint64_t exponent) const {
+			basic_modint base = *this;
+			basic_modint result = from_form(arithmetic().one());
+			for (; exponent > 0; exponent >>= 1) {
+				if (exponent & 1) {
+					result *= base;
+				}
+				base *= base;
+			}
+			return result;
+		}
+
+		// Inverse by the extended Euclidean algorithm, so composite moduli work
+		// too. Throws std::invalid_argument when gcd(value, mod) != 1.
+		[[nodiscard]] constexpr basic_modint inverse() const {
+			// Invariant: old_coefficient * value == old_remainder (mod mod), with
+			// the coefficients tracked modulo mod so they stay unsigned.
+			std::uint64_t old_remainder = value();
+			std::uint64_t remainder = mod();
+			basic_modint old_coefficient = 1;
+			basic_modint coefficient = 0;
+			while (remainder != 0) {
+				const std::uint64_t quotient = old_remainder / remainder;
+				old_remainder = std::exchange(remainder, old_remainder - quotient * remainder);
+				old_coefficient = std::exchange(coefficient, old_coefficient - basic_modint(quotient) * coefficient);
+			}
+			if (old_remainder != 1 && mod() != 1) {
+				throw std::invalid_argument("Value is not invertible modulo the modulus.");
+			}
+			return old_coefficient;
+		}
+
+		friend std::ostream &operator<<(std::ostream &os, const basic_modint &x) { return os << x.value(); }
+
+	private:
+		[[nodiscard]] static constexpr const auto &arithmetic() { return Context::arithmetic; }
+
+		[[nodiscard]] static constexpr basic_modint from_form(const std::uint64_t form) {
+			basic_modint result {};
+			result.form_ = form;
+			return result;
+		}
+
+		std::uint64_t form_;
+	};
+
+	template<std::uint64_t Mod>
+	using modint = basic_modint<static_modulus<Mod>>;
+
+	template<int Id = 0>
+	using dynamic_modint = basic_modint<dynamic_modulus<Id>>;
+
+	// Invert every element in place with Montgomery's trick: one inverse and
+	// about 3n multiplications in total. Throws std::invalid_argument, leaving
+	// values untouched, when any element is not invertible.
+	template<typename Context>
+	constexpr void batch_invert(const std::span<basic_modint<Context>> values) {
+		if (values.empty()) {
+			return;
+		}
+		std::vector<basic_modint<Context>> prefix(values.size());
+		prefix[0] = values[0];
+		for (std::size_t i = 1; i < values.size(); i++) {
+			prefix[i] = prefix[i - 1] * values[i];
+		}
+		basic_modint<Context> inverse = prefix.back().inverse();
+		for (std::size_t i = values.size() - 1; i > 0; i--) {
+			const basic_modint<Context> original = values[i];
+			values[i] = inverse * prefix[i - 1];
+			inverse *= original;
+		}
+		values[0] = inverse;
+	}
+}
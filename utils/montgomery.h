@@ -0,0 +1,228 @@
+#pragma once
+#include "precompile_header.h"
+#include "int128.h"
+
+namespace utils {
+
+	// Integer widths the modular and prime utilities are instantiated for.
+	template<typename T>
+	concept modular_width = std::same_as<T, std::uint32_t> || std::same_as<T, std::uint64_t> || std::same_as<T, uint128_t>;
+
+	namespace detail {
+		// High and low halves of the full 2*width product a*b.
+		constexpr std::pair<std::uint64_t, std::uint64_t> mul_wide(const std::uint64_t a, const std::uint64_t b) {
+			const uint128_t product = static_cast<uint128_t>(a) * b;
+			return {static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product)};
+		}
+
+		constexpr std::pair<uint128_t, uint128_t> mul_wide(const uint128_t a, const uint128_t b) {
+			constexpr uint128_t low_mask = ~std::uint64_t {0};
+			const uint128_t a_lo = a & low_mask;
+			const uint128_t a_hi = a >> 64;
+			const uint128_t b_lo = b & low_mask;
+			const uint128_t b_hi = b >> 64;
+
+			const uint128_t lo_lo = a_lo * b_lo;
+			const uint128_t hi_lo = a_hi * b_lo;
+			const uint128_t lo_hi = a_lo * b_hi;
+			const uint128_t hi_hi = a_hi * b_hi;
+
+			const uint128_t middle = (lo_lo >> 64) + (hi_lo & low_mask) + (lo_hi & low_mask);
+			return {hi_hi + (hi_lo >> 64) + (lo_hi >> 64) + (middle >> 64), (middle << 64) | (lo_lo & low_mask)};
+		}
+
+		template<typename T>
+		constexpr T binary_gcd(T a, T b) {
+			if (a == 0) {
+				return b;
+			}
+			if (b == 0) {
+				return a;
+			}
+			auto trailing_zeros = [](T x) {
+				int count = 0;
+				for (; (x & 1) == 0; x >>= 1) {
+					count++;
+				}
+				return count;
+			};
+			const int shift = trailing_zeros(a | b);
+			a >>= trailing_zeros(a);
+			do {
+				b >>= trailing_zeros(b);
+				if (a > b) {
+					std::swap(a, b);
+				}
+				b -= a;
+			} while (b != 0);
+			return a << shift;
+		}
+	}
+
+	// Arithmetic modulo a 32-bit n using a native 64-bit product. Shares the
+	// interface of montgomery<T> so generic code can pick either; the "form"
+	// of a residue is the residue itself.
+	template<typename T>
+	class native_modulus {
+	public:
+		using value_type = T;
+
+		constexpr explicit native_modulus(const T mod) : mod_(mod) {}
+
+		[[nodiscard]] constexpr T mod() const { return mod_; }
+		[[nodiscard]] constexpr T to_form(const T x) const { return x % mod_; }
+		[[nodiscard]] constexpr T from_form(const T x) const { return x; }
+		[[nodiscard]] constexpr T one() const { return 1 % mod_; }
+
+		[[nodiscard]] constexpr T mul(const T a, const T b) const {
+			return static_cast<T>(static_cast<std::uint64_t>(a) * b % mod_);
+		}
+
+		[[nodiscard]] constexpr T add(const T a, const T b) const { return a >= mod_ - b ? a - (mod_ - b) : a + b; }
+		[[nodiscard]] constexpr T sub(const T a, const T b) const { return a >= b ? a - b : a + (mod_ - b); }
+
+		template<typename Exponent>
+		[[nodiscard]] constexpr T pow(T base, Exponent exponent) const {
+			T result = one();
+			while (exponent > 0) {
+				if (exponent & 1) {
+					result = mul(result, base);
+				}
+				base = mul(base, base);
+				exponent >>= 1;
+			}
+			return result;
+		}
+
+	private:
+		T mod_;
+	};
+
+	// Montgomery arithmetic modulo an odd n < 2^width with R = 2^width.
+	// Residues are kept in form x*R mod n, where multiplication needs two
+	// wide multiplies and no division.
+	template<typename T>
+	class montgomery {
+	public:
+		using value_type = T;
+
+		constexpr explicit montgomery(const T mod) : mod_(mod), inverse_(mod) {
+			if (mod % 2 == 0) {
+				throw std::invalid_argument("Montgomery arithmetic needs an odd modulus.");
+			}
+			// Newton's iteration doubles the correct low bits of n^-1 mod R each round.
+			for (std::size_t bits = 3; bits < sizeof(T) * 8; bits *= 2) {
+				inverse_ *= 2 - mod_ * inverse_;
+			}
+			// R mod n, then doubled width times to reach R^2 mod n.
+			r_mod_ = static_cast<T>(T {0} - mod_) % mod_;
+			r_squared_ = r_mod_;
+			for (std::size_t i = 0; i < sizeof(T) * 8; i++) {
+				r_squared_ = add(r_squared_, r_squared_);
+			}
+		}
+
+		[[nodiscard]] constexpr T mod() const { return mod_; }
+		// Any x < R works: x * R^2 mod n stays below n*R, all reduce needs.
+		[[nodiscard]] constexpr T to_form(const T x) const { return mul(x, r_squared_); }
+		[[nodiscard]] constexpr T from_form(const T x) const { return reduce(0, x); }
+		[[nodiscard]] constexpr T one() const { return r_mod_; }
+
+		[[nodiscard]] constexpr T mul(const T a, const T b) const {
+			const auto [high, low] = detail::mul_wide(a, b);
+			return reduce(high, low);
+		}
+
+		[[nodiscard]] constexpr T add(const T a, const T b) const { return a >= mod_ - b ? a - (mod_ - b) : a + b; }
+		[[nodiscard]] constexpr T sub(const T a, const T b) const { return a >= b ? a - b : a + (mod_ - b); }
+
+		template<typename Exponent>
+		[[nodiscard]] constexpr T pow(T base, Exponent exponent) const {
+			T result = one();
+			while (exponent > 0) {
+				if (exponent & 1) {
+					result = mul(result, base);
+				}
+				base = mul(base, base);
+				exponent >>= 1;
+			}
+			return result;
+		}
+
+	private:
+		// (high*R + low) / R mod n. The low word of m*n equals low, so only
+		// the high words need subtracting.
+		[[nodiscard]] constexpr T reduce(const T high, const T low) const {
+			const T m = low * inverse_;
+			const T correction = detail::mul_wide(m, mod_).first;
+			return high >= correction ? high - correction : high + (mod_ - correction);
+		}
+
+		T mod_;
+		T inverse_;
+		T r_mod_ {};
+		T r_squared_ {};
+	};
+
+	// Barrett reduction modulo any n >= 1, even ones included, with the same
+	// interface as montgomery<T>. A precomputed m = floor((W - 1) / n) for
+	// W = 2^(2*width) turns each reduction into a high multiply, a low
+	// multiply and at most two subtractions. Residues are kept as themselves.
+	template<typename T>
+	class barrett {
+		using wide = std::conditional_t<sizeof(T) <= 4, std::uint64_t, uint128_t>;
+
+	public:
+		using value_type = T;
+
+		constexpr explicit barrett(const T mod) : mod_(mod), factor_(static_cast<wide>(~wide {0}) / mod) {}
+
+		[[nodiscard]] constexpr T mod() const { return mod_; }
+		// Takes any x below W, not just below n.
+		[[nodiscard]] constexpr T to_form(const wide x) const { return reduce(x); }
+		[[nodiscard]] constexpr T from_form(const T x) const { return x; }
+		[[nodiscard]] constexpr T one() const { return mod_ == 1 ? 0 : 1; }
+
+		[[nodiscard]] constexpr T mul(const T a, const T b) const { return reduce(static_cast<wide>(a) * b); }
+
+		[[nodiscard]] constexpr T add(const T a, const T b) const { return a >= mod_ - b ? a - (mod_ - b) : a + b; }
+		[[nodiscard]] constexpr T sub(const T a, const T b) const { return a >= b ? a - b : a + (mod_ - b); }
+
+		template<typename Exponent>
+		[[nodiscard]] constexpr T pow(T base, Exponent exponent) const {
+			T result = one();
+			while (exponent > 0) {
+				if (exponent & 1) {
+					result = mul(result, base);
+				}
+				base = mul(base, base);
+				exponent >>= 1;
+			}
+			return result;
+		}
+
+	private:
+		// x mod n for any x below W. The quotient estimate is at most two short.
+		[[nodiscard]] constexpr T reduce(const wide x) const {
+			wide quotient {};
+			if constexpr (sizeof(T) <= 4) {
+				quotient = static_cast<std::uint64_t>((static_cast<uint128_t>(x) * factor_) >> 64);
+			} else {
+				quotient = detail::mul_wide(x, factor_).first;
+			}
+			wide remainder = x - quotient * mod_;
+			while (remainder >= mod_) {
+				remainder -= mod_;
+			}
+			return static_cast<T>(remainder);
+		}
+
+		T mod_;
+		wide factor_;
+	};
+
+	// The fastest modular multiplier for each width: a native product for
+	// 32-bit moduli, Montgomery form for 64 and 128-bit ones.
+	template<modular_width T>
+	using modular_arithmetic = std::conditional_t<sizeof(T) <= 4, native_modulus<T>, montgomery<T>>;
+}
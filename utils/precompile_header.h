@@ -7,9 +7,18 @@
 #include <filesystem>
 #include <fstream>
 #include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <bit>
+#include <span>
+#include <array>
 
 #include <format>
 #include <tuple>
+#include <optional>
+#include <utility>
+#include <memory>
+#include <random>
 #include <set>
 #include <map>
 #include <list>
@@ -22,6 +31,7 @@
 #include <algorithm>
 #include <cmath>
 #include <regex>
+#include <stdexcept>
 
 #include <thread>
 #include <chrono>
@@ -29,6 +39,7 @@
 #include <atomic>
 #include <cstdio>
 #include <mutex>
+#include <exception>
 
 #include "imgui.h"
 #include "backends/imgui_impl_glfw.h"
@@ -0,0 +1,151 @@
+#include "prime_cache.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace utils {
+	namespace {
+		// On-disk layout: this header, then word_count 64-bit words of the
+		// odd-only table. 32 bytes keeps the words 8-byte aligned in the mapping.
+		struct prime_table_header {
+			char magic[8];
+			std::uint32_t version;
+			// 0x01020304 as stored by the machine that wrote the file.
+			std::uint32_t byte_order;
+			std::uint64_t limit;
+			std::uint64_t word_count;
+		};
+		static_assert(sizeof(prime_table_header) == 32);
+
+		constexpr char prime_table_magic[8] = {'C', 'C', 'P', 'R', 'I', 'M', 'E', 'S'};
+		constexpr std::uint32_t prime_table_byte_order = 0x01020304;
+
+		std::uint64_t words_for_limit(const std::uint64_t limit) {
+			return (limit / 2 + 1 + 63) / 64;
+		}
+	}
+
+	std::filesystem::path prime_table_cache::default_path() {
+		if (const char *configured = std::getenv("CODING_CHALLENGES_PRIME_CACHE")) {
+			return configured;
+		}
+		return std::filesystem::temp_directory_path() / "coding_challenges_primes.v1.bin";
+	}
+
+	prime_table_cache &prime_table_cache::shared() {
+		static prime_table_cache cache {};
+		return cache;
+	}
+
+	prime_table_cache::prime_table_cache(std::filesystem::path path, const std::uint64_t initial_limit, const std::uint64_t max_limit)
+		: path_(std::move(path)), max_limit_(max_limit) {
+		reserve(initial_limit);
+	}
+
+	std::uint64_t prime_table_cache::limit() const {
+		return current()->limit;
+	}
+
+	std::shared_ptr<const prime_table_cache::table> prime_table_cache::current() const {
+		std::lock_guard lock(table_mtx_);
+		return table_;
+	}
+
+	std::shared_ptr<const prime_table_cache::table> prime_table_cache::try_open(const std::uint64_t limit) const {
+		std::error_code error {};
+		if (!std::filesystem::is_regular_file(path_, error)) {
+			return nullptr;
+		}
+
+		auto opened = std::make_shared<table>();
+		try {
+			opened->file = mapped_file(path_);
+		} catch (const std::runtime_error &) {
+			return nullptr;
+		}
+		const std::span<const std::byte> bytes = opened->file.bytes();
+		if (bytes.size() < sizeof(prime_table_header)) {
+			return nullptr;
+		}
+
+		prime_table_header header {};
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		const bool valid = std::memcmp(header.magic, prime_table_magic, sizeof(prime_table_magic)) == 0
+			&& header.version == format_version
+			&& header.byte_order == prime_table_byte_order
+			&& header.word_count == words_for_limit(header.limit)
+			&& bytes.size() == sizeof(header) + header.word_count * sizeof(std::uint64_t);
+		if (!valid || header.limit < limit) {
+			return nullptr;
+		}
+
+		opened->limit = header.limit;
+		opened->words = {reinterpret_cast<const std::uint64_t *>(bytes.data() + sizeof(header)), header.word_count};
+		return opened;
+	}
+
+	void prime_table_cache::regenerate(const std::uint64_t limit) const {
+		const prime_sieve sieve(limit);
+		prime_table_header header {};
+		std::memcpy(header.magic, prime_table_magic, sizeof(prime_table_magic));
+		header.version = format_version;
+		header.byte_order = prime_table_byte_order;
+		header.limit = limit;
+		header.word_count = sieve.odd_bits().size();
+
+		// Write beside the target and rename over it, which is atomic on POSIX.
+		std::filesystem::path temporary = path_;
+		temporary += ".tmp-" + std::to_string(std::random_device {}());
+		{
+			std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+			out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+			out.write(reinterpret_cast<const char *>(sieve.odd_bits().data()),
+			          static_cast<std::streamsize>(sieve.odd_bits().size_bytes()));
+			if (!out) {
+				std::filesystem::remove(temporary);
+				throw std::runtime_error("Could not write prime table cache " + temporary.string() + ".");
+			}
+		}
+
+		std::error_code error {};
+		std::filesystem::rename(temporary, path_, error);
+		if (error) {
+			std::filesystem::remove(temporary);
+			throw std::runtime_error("Could not replace prime table cache " + path_.string() + ": " + error.message());
+		}
+	}
+
+	void prime_table_cache::reserve(std::uint64_t limit) {
+		limit = std::min(limit, max_limit_);
+		std::lock_guard lock(table_mtx_);
+		if (table_ != nullptr && table_->limit >= limit) {
+			return;
+		}
+
+		// Another process may already have grown the file.
+		if (auto opened = try_open(limit)) {
+			table_ = std::move(opened);
+			return;
+		}
+
+		const std::uint64_t grown = table_ == nullptr ? limit : std::min(std::max(limit, 2 * table_->limit), max_limit_);
+		regenerate(grown);
+		auto opened = try_open(limit);
+		if (opened == nullptr) {
+			throw std::runtime_error("Prime table cache " + path_.string() + " is unreadable after regenerating it.");
+		}
+		table_ = std::move(opened);
+	}
+
+	bool prime_table_cache::is_prime(const std::uint64_t n) {
+		if (n % 2 == 0) {
+			return n == 2;
+		}
+		if (n > max_limit_) {
+			return utils::is_prime(n);
+		}
+		reserve(n);
+		const std::uint64_t bit = n / 2;
+		return (current()->words[bit / 64] >> (bit % 64)) & 1;
+	}
+}
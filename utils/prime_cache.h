@@ -0,0 +1,129 @@
+#pragma once
+#include "precompile_header.h"
+#include "mapped_file.h"
+#include "prime_utils.h"
+
+namespace utils {
+
+	// Prime table persisted on disk and memory-mapped read-only, so the
+	// processes that use it share one copy through the page cache and sieve
+	// it only once.
+	//
+	// The file is a fixed header followed by the bit-packed odd-only table of
+	// prime_sieve. A query above the cached limit regenerates the file with
+	// at least double the limit, up to max_limit. The new file is written
+	// next to the old one and renamed over it, so concurrent readers keep
+	// their old mapping and never see a partial table. Queries past
+	// max_limit never grow the file: is_prime falls back to Miller-Rabin and
+	// for_each_prime to the segmented sieve.
+	//
+	// The cache is opt-in: primes_up_to, prime_sieve and is_prime keep
+	// sieving in memory and never touch the disk. Callers that query the
+	// same range across many runs use the shared instance instead:
+	//
+	//     prime_table_cache &cache = prime_table_cache::shared();
+	//     cache.for_each_prime(0, 10000000, [&](std::uint64_t p) { ... });
+	//
+	// Util-Bench's prime_table_cache entry is such a caller.
+	class prime_table_cache {
+	public:
+		static constexpr std::uint32_t format_version = 1;
+		static constexpr std::uint64_t default_initial_limit = std::uint64_t {1} << 24;
+		// A 256 MiB file; sieving it also takes that much memory once.
+		static constexpr std::uint64_t default_max_limit = std::uint64_t {1} << 32;
+
+		// $CODING_CHALLENGES_PRIME_CACHE if set, else a file in the temp directory.
+		static std::filesystem::path default_path();
+
+		// Process-wide cache on default_path().
+		static prime_table_cache &shared();
+
+		// initial_limit is clamped to max_limit.
+		explicit prime_table_cache(
+			std::filesystem::path path = default_path(),
+			std::uint64_t initial_limit = default_initial_limit,
+			std::uint64_t max_limit = default_max_limit
+		);
+
+		[[nodiscard]] const std::filesystem::path &path() const { return path_; }
+
+		// Largest number the current mapping covers.
+		[[nodiscard]] std::uint64_t limit() const;
+
+		// The file never grows past this.
+		[[nodiscard]] std::uint64_t max_limit() const { return max_limit_; }
+
+		// Grow the file, if needed, until it covers min(limit, max_limit()).
+		void reserve(std::uint64_t limit);
+
+		bool is_prime(std::uint64_t n);
+
+		// Visit the primes in [lo, hi] in increasing order, growing first if hi
+		// is past the limit. The part of the range above max_limit() goes
+		// through utils::for_each_prime. The callback may return false to stop.
+		template<typename Callback>
+		void for_each_prime(const std::uint64_t lo, const std::uint64_t hi, Callback &&callback) {
+			if (hi < lo) {
+				return;
+			}
+			if (lo <= max_limit_ && !for_each_cached_prime(lo, std::min(hi, max_limit_), callback)) {
+				return;
+			}
+			if (hi > max_limit_) {
+				utils::for_each_prime(std::max(lo, max_limit_ + 1), hi, callback);
+			}
+		}
+
+	private:
+		struct table {
+			mapped_file file;
+			std::uint64_t limit {0};
+			std::span<const std::uint64_t> words;
+		};
+
+		// for_each_prime over the mapped table, hi <= max_limit_. Returns false
+		// if the callback stopped the walk.
+		template<typename Callback>
+		bool for_each_cached_prime(const std::uint64_t lo, const std::uint64_t hi, Callback &callback) {
+			reserve(hi);
+			const std::shared_ptr<const table> snapshot = current();
+			if (lo <= 2 && hi >= 2 && !detail::invoke_prime_callback(callback, 2)) {
+				return false;
+			}
+			// No odd primes below 3; (hi - 1) / 2 would also wrap for hi == 0.
+			if (hi < 3) {
+				return true;
+			}
+			// Bits for odd n in [max(lo, 3), hi].
+			const std::uint64_t first_bit = std::max<std::uint64_t>(lo, 3) / 2;
+			const std::uint64_t last_bit = (hi - 1) / 2;
+			for (std::uint64_t w = first_bit / 64; w <= last_bit / 64 && first_bit <= last_bit; w++) {
+				std::uint64_t bits = snapshot->words[w];
+				if (w == first_bit / 64) {
+					bits &= ~std::uint64_t {0} << (first_bit % 64);
+				}
+				if (w == last_bit / 64 && last_bit % 64 != 63) {
+					bits &= (std::uint64_t {2} << (last_bit % 64)) - 1;
+				}
+				for (; bits != 0; bits &= bits - 1) {
+					if (!detail::invoke_prime_callback(callback, 2 * (64 * w + std::countr_zero(bits)) + 1)) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		// Map the file if its header is valid and it covers at least limit.
+		[[nodiscard]] std::shared_ptr<const table> try_open(std::uint64_t limit) const;
+
+		void regenerate(std::uint64_t limit) const;
+
+		[[nodiscard]] std::shared_ptr<const table> current() const;
+
+		std::filesystem::path path_;
+		std::uint64_t max_limit_;
+		mutable std::mutex table_mtx_;
+		std::shared_ptr<const table> table_;
+	};
+}
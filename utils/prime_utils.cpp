@@ -1,24 +1,833 @@
 #include "prime_utils.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
 namespace utils {
-	std::map<int, int> prime_count_map(const int number) {
-		std::map<int, int> result {};
-		int current_number = number;
-		int factor = 2;
-
-		while (current_number != 1) {
-			if (current_number%factor == 0) {
-				if (result.contains(factor)) {
-					result[factor] = result[factor] + 1;
+	const std::array<std::uint32_t, 6542> small_primes = make_prime_table<65536>();
+
+	std::uint64_t isqrt(const std::uint64_t n) {
+		std::uint64_t root = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+		while (root > 0 && root > n / root) {
+			root--;
+		}
+		while (root + 1 <= n / (root + 1)) {
+			root++;
+		}
+		return root;
+	}
+
+	namespace {
+		// Sieve the odd numbers of [low, high] into words, low a multiple of 128.
+		// Bits for numbers below lo are cleared. next_multiple holds each base
+		// prime's next odd multiple on entry and is advanced past high, so
+		// consecutive windows need no divisions. Returns the words used.
+		std::size_t sieve_window(
+			const std::uint64_t low,
+			const std::uint64_t high,
+			const std::uint64_t lo,
+			const std::vector<std::uint64_t> &base_primes,
+			std::vector<std::uint64_t> &next_multiple,
+			std::vector<std::uint64_t> &words
+		) {
+			const std::size_t bit_count = (high - low + 1) / 2;
+			const std::size_t word_count = (bit_count + 63) / 64;
+
+			std::fill_n(words.begin(), word_count, ~std::uint64_t {0});
+			if (bit_count % 64 != 0) {
+				words[word_count - 1] &= (std::uint64_t {1} << (bit_count % 64)) - 1;
+			}
+			if (low < lo) {
+				const std::size_t below_lo = (lo - low) / 2;
+				for (std::size_t i = 0; i < below_lo; i++) {
+					words[i / 64] &= ~(std::uint64_t {1} << (i % 64));
+				}
+			}
+			if (low == 0) {
+				words[0] &= ~std::uint64_t {1};
+			}
+
+			for (std::size_t b = 0; b < base_primes.size(); b++) {
+				const std::uint64_t p = base_primes[b];
+				if (p * p > high) {
+					break;
+				}
+				std::uint64_t bit = (next_multiple[b] - low - 1) / 2;
+				for (; bit < bit_count; bit += p) {
+					words[bit / 64] &= ~(std::uint64_t {1} << (bit % 64));
+				}
+				next_multiple[b] = low + 1 + 2 * bit;
+			}
+			return word_count;
+		}
+
+		// First odd multiple of p at or above max(p^2, low + 1).
+		std::uint64_t first_odd_multiple(const std::uint64_t p, const std::uint64_t low) {
+			const std::uint64_t first_multiple = std::max(p * p, ((low + p) / p) * p);
+			return first_multiple % 2 == 0 ? first_multiple + p : first_multiple;
+		}
+
+		// Geometry and base primes for sieving [lo, hi]. Segments start on
+		// multiples of 128 so whole 64-bit words line up with a table that
+		// starts at zero.
+		class sieve_plan {
+		public:
+			sieve_plan(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes)
+				: lo_(std::max<std::uint64_t>(lo, 2)),
+				  hi_(hi),
+				  words_per_segment_(std::max<std::size_t>(1, (segment_bytes + 7) / 8)),
+				  span_(static_cast<std::uint64_t>(words_per_segment_) * 128),
+				  first_low_(lo_ & ~std::uint64_t {127}) {
+				if (hi_ < lo_) {
+					return;
+				}
+				segment_count_ = (hi_ - first_low_) / span_ + 1;
+				// The odd base primes up to sqrt(hi) come from a recursive call on the same sieve.
+				for_each_prime(3, isqrt(hi_), [&](const std::uint64_t p) { base_primes_.push_back(p); });
+			}
+
+			[[nodiscard]] std::uint64_t segment_count() const { return segment_count_; }
+			[[nodiscard]] std::size_t words_per_segment() const { return words_per_segment_; }
+
+			// Each base prime's first odd multiple in or after segment index.
+			[[nodiscard]] std::vector<std::uint64_t> first_multiples(const std::uint64_t index) const {
+				const std::uint64_t low = first_low_ + index * span_;
+				std::vector<std::uint64_t> multiples {};
+				multiples.reserve(base_primes_.size());
+				for (const std::uint64_t p : base_primes_) {
+					multiples.push_back(first_odd_multiple(p, low));
+				}
+				return multiples;
+			}
+
+			// Sieve segment number index into words. next_multiple holds each base
+			// prime's next odd multiple on entry and is advanced past the segment,
+			// so consecutive segments need no divisions.
+			prime_segment sieve(const std::uint64_t index, std::vector<std::uint64_t> &words, std::vector<std::uint64_t> &next_multiple) const {
+				const std::uint64_t low = first_low_ + index * span_;
+				const std::uint64_t high = hi_ - low < span_ ? hi_ : low + span_ - 1;
+				words.resize(words_per_segment_);
+				const std::size_t word_count = sieve_window(low, high, lo_, base_primes_, next_multiple, words);
+				return {low + 1, std::span(words.data(), word_count), index == 0 && lo_ <= 2};
+			}
+
+		private:
+			std::uint64_t lo_;
+			std::uint64_t hi_;
+			std::size_t words_per_segment_;
+			std::uint64_t span_;
+			std::uint64_t first_low_;
+			std::uint64_t segment_count_ {0};
+			std::vector<std::uint64_t> base_primes_ {};
+		};
+	}
+
+	void for_each_prime_segment(
+		const std::uint64_t lo,
+		const std::uint64_t hi,
+		const std::function<bool(const prime_segment &)> &callback,
+		const std::size_t segment_bytes
+	) {
+		const sieve_plan plan(lo, hi, segment_bytes);
+		if (plan.segment_count() == 0) {
+			return;
+		}
+
+		std::vector<std::uint64_t> words {};
+		std::vector<std::uint64_t> next_multiple = plan.first_multiples(0);
+		for (std::uint64_t index = 0; index < plan.segment_count(); index++) {
+			if (!callback(plan.sieve(index, words, next_multiple))) {
+				return;
+			}
+		}
+	}
+
+	void for_each_prime_segment_parallel(
+		const std::uint64_t lo,
+		const std::uint64_t hi,
+		const std::function<void(std::uint64_t, const prime_segment &)> &callback,
+		unsigned threads,
+		const std::size_t segment_bytes
+	) {
+		const sieve_plan plan(lo, hi, segment_bytes);
+		if (plan.segment_count() == 0) {
+			return;
+		}
+		if (threads == 0) {
+			threads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		threads = static_cast<unsigned>(std::min<std::uint64_t>(threads, plan.segment_count()));
+
+		// Workers claim runs of consecutive segments, so only the first segment
+		// of each run pays a division per base prime.
+		constexpr std::uint64_t segments_per_claim = 8;
+		std::atomic<std::uint64_t> cursor {0};
+		std::exception_ptr failure {};
+		std::mutex failure_mtx;
+
+		auto worker = [&] {
+			try {
+				std::vector<std::uint64_t> words {};
+				for (;;) {
+					const std::uint64_t first = cursor.fetch_add(segments_per_claim);
+					if (first >= plan.segment_count()) {
+						return;
+					}
+					const std::uint64_t last = std::min(first + segments_per_claim, plan.segment_count());
+					std::vector<std::uint64_t> next_multiple = plan.first_multiples(first);
+					for (std::uint64_t index = first; index < last; index++) {
+						callback(index, plan.sieve(index, words, next_multiple));
+					}
+				}
+			} catch (...) {
+				// Stop handing out work and rethrow the first failure on the caller's thread.
+				cursor = plan.segment_count();
+				std::lock_guard lock(failure_mtx);
+				if (!failure) {
+					failure = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> workers {};
+		for (unsigned t = 1; t < threads; t++) {
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (std::thread &thread : workers) {
+			thread.join();
+		}
+		if (failure) {
+			std::rethrow_exception(failure);
+		}
+	}
+
+	incremental_prime_sieve::incremental_prime_sieve(const std::uint64_t from, const std::size_t segment_bytes)
+		: from_(std::max<std::uint64_t>(from, 2)),
+		  first_low_(from_ & ~std::uint64_t {127}),
+		  next_low_(first_low_),
+		  words_(std::max<std::size_t>(1, (segment_bytes + 7) / 8)) {}
+
+	prime_segment incremental_prime_sieve::next_segment() {
+		const std::uint64_t low = next_low_;
+		const std::uint64_t span = static_cast<std::uint64_t>(words_.size()) * 128;
+		const std::uint64_t high = std::numeric_limits<std::uint64_t>::max() - low < span ? std::numeric_limits<std::uint64_t>::max() : low + span - 1;
+
+		// Pull in the base primes this segment needs that earlier ones did not.
+		const std::uint64_t root = isqrt(high);
+		if (root > base_bound_) {
+			for_each_prime(std::max<std::uint64_t>(3, base_bound_ + 1), root, [&](const std::uint64_t p) {
+				base_primes_.push_back(p);
+				next_multiple_.push_back(first_odd_multiple(p, low));
+			});
+			base_bound_ = root;
+		}
+
+		const std::size_t word_count = sieve_window(low, high, from_, base_primes_, next_multiple_, words_);
+		next_low_ = low + span;
+		return {low + 1, std::span(words_.data(), word_count), low == first_low_ && from_ <= 2};
+	}
+
+	std::vector<std::uint64_t> primes_in_range(const std::uint64_t lo, const std::uint64_t hi, const unsigned threads) {
+		std::vector<std::vector<std::uint64_t>> per_segment {};
+		std::mutex per_segment_mtx;
+
+		for_each_prime_segment_parallel(lo, hi, [&](const std::uint64_t index, const prime_segment &segment) {
+			std::vector<std::uint64_t> primes {};
+			segment.for_each_prime([&](const std::uint64_t p) { primes.push_back(p); });
+			std::lock_guard lock(per_segment_mtx);
+			if (per_segment.size() <= index) {
+				per_segment.resize(index + 1);
+			}
+			per_segment[index] = std::move(primes);
+		}, threads);
+
+		std::size_t total = 0;
+		for (const auto &primes : per_segment) {
+			total += primes.size();
+		}
+		std::vector<std::uint64_t> result {};
+		result.reserve(total);
+		for (const auto &primes : per_segment) {
+			result.insert(result.end(), primes.begin(), primes.end());
+		}
+		return result;
+	}
+
+	std::vector<std::uint64_t> primes_up_to(const std::uint64_t limit) {
+		std::vector<std::uint64_t> primes {};
+		if (limit >= 2) {
+			// pi(x) < 1.26 x / ln(x) for x > 1.
+			primes.reserve(static_cast<std::size_t>(1.26 * static_cast<double>(limit) / std::log(static_cast<double>(limit))) + 1);
+		}
+		for_each_prime(2, limit, [&](const std::uint64_t p) { primes.push_back(p); });
+		return primes;
+	}
+
+	namespace {
+		// floor(x / d). Below 2^53 both operands are exact doubles, and a double
+		// divide with a one-step fix-up is several times cheaper than a 64-bit
+		// integer divide.
+		std::uint64_t floor_divide(const std::uint64_t x, const std::uint64_t d) {
+			if (x >= std::uint64_t {1} << 53) {
+				return x / d;
+			}
+			auto quotient = static_cast<std::uint64_t>(static_cast<double>(x) / static_cast<double>(d));
+			if (quotient * d > x) {
+				quotient--;
+			} else if ((quotient + 1) * d <= x) {
+				quotient++;
+			}
+			return quotient;
+		}
+
+		// Lucy_Hedgehog's dynamic programming. S(v) starts as the sum of f(n)
+		// over 2 <= n <= v and sieving out each prime p <= sqrt(x) in turn
+		// leaves the sum over primes only:
+		//     S(v) -= f(p) * (S(v / p) - S(p - 1))    for v >= p^2.
+		// f is 1 or n, both completely multiplicative. Only the values
+		// floor(x/k) are ever needed: those up to sqrt(x) live in small,
+		// indexed by v, and the rest in large, indexed by k.
+		template<typename Large, typename Prefix>
+		Large lucy_prime_sum(const std::uint64_t x, const bool weighted, unsigned threads, Prefix prefix) {
+			if (x < 2) {
+				return 0;
+			}
+			const std::uint64_t root = isqrt(x);
+			// S(v) for v <= sqrt(x) is below x, so small fits 64 bits either way.
+			std::vector<std::uint64_t> small(root + 1);
+			std::vector<Large> large(root + 1);
+			for (std::uint64_t v = 1; v <= root; v++) {
+				small[v] = static_cast<std::uint64_t>(prefix(v));
+			}
+			for (std::uint64_t k = 1; k <= root; k++) {
+				large[k] = prefix(x / k);
+			}
+			if (threads == 0) {
+				threads = std::max(1U, std::thread::hardware_concurrency());
+			}
+
+			for (std::uint64_t p = 2; p <= root; p++) {
+				if (small[p] == small[p - 1]) {
+					continue;
+				}
+				const std::uint64_t below = small[p - 1];
+				const std::uint64_t weight = weighted ? p : 1;
+				const std::uint64_t last = std::min(root, x / (p * p));
+
+				// For k*p <= sqrt(x), S(x/(k*p)) is large[k*p], which ascending k
+				// reaches only after reading it.
+				const std::uint64_t direct = std::min(last, root / p);
+				for (std::uint64_t k = 1; k <= direct; k++) {
+					large[k] -= Large {weight} * (large[k * p] - below);
+				}
+
+				// The rest read only small, which is updated last, so they are
+				// independent and can be split across threads.
+				auto sieve_large = [&](const std::uint64_t first, const std::uint64_t end) {
+					for (std::uint64_t k = first; k < end; k++) {
+						large[k] -= Large {weight} * (small[floor_divide(x, k * p)] - below);
+					}
+				};
+				constexpr std::uint64_t min_entries_per_thread = 1 << 15;
+				const std::uint64_t count = last - direct;
+				const auto workers = static_cast<unsigned>(std::min<std::uint64_t>(threads, count / min_entries_per_thread));
+				if (workers <= 1) {
+					sieve_large(direct + 1, last + 1);
 				} else {
-					result[factor] = 1;
+					std::vector<std::thread> pool {};
+					for (unsigned t = 1; t < workers; t++) {
+						pool.emplace_back(sieve_large, direct + 1 + count * t / workers, direct + 1 + count * (t + 1) / workers);
+					}
+					sieve_large(direct + 1, direct + 1 + count / workers);
+					for (std::thread &thread : pool) {
+						thread.join();
+					}
+				}
+
+				// Descending v, so S(v/p) is read before it changes. Every v in
+				// [q*p, q*p + p) shares the quotient q, which saves the divisions.
+				for (std::uint64_t q = root / p; q >= p; q--) {
+					const std::uint64_t delta = weight * (small[q] - below);
+					for (std::uint64_t v = q * p; v < std::min(q * p + p, root + 1); v++) {
+						small[v] -= delta;
+					}
 				}
-				current_number = current_number/factor;
-			} else {
-				factor++;
 			}
+			return large[1];
 		}
+	}
+
+	std::uint64_t prime_pi(const std::uint64_t x, const unsigned threads) {
+		return lucy_prime_sum<std::uint64_t>(x, false, threads, [](const std::uint64_t v) { return v - 1; });
+	}
+
+	uint128_t prime_sum(const std::uint64_t x, const unsigned threads) {
+		return lucy_prime_sum<uint128_t>(x, true, threads, [](const std::uint64_t v) {
+			// Widened before adding 1, which would wrap at v = 2^64 - 1.
+			return uint128_t {v} * (uint128_t {v} + 1) / 2 - 1;
+		});
+	}
+
+	prime_sieve::prime_sieve(const std::uint64_t limit, const std::size_t segment_bytes)
+		: limit_(limit), odd_bits_((limit / 2 + 1 + 63) / 64, 0) {
+		std::uint64_t *destination = odd_bits_.data();
+		for_each_prime_segment(0, limit, [&](const prime_segment &segment) {
+			std::ranges::copy(segment.words, destination);
+			destination += segment.words.size();
+			return true;
+		}, segment_bytes);
+
+		for (const std::uint64_t word : odd_bits_) {
+			count_ += std::popcount(word);
+		}
+		if (limit >= 2) {
+			count_++;
+		}
+	}
+
+	bool prime_sieve::is_prime(const std::uint64_t n) const {
+		if (n > limit_) {
+			throw std::out_of_range("Number is above the sieve limit.");
+		}
+		if (n % 2 == 0) {
+			return n == 2;
+		}
+		const std::uint64_t index = n / 2;
+		return (odd_bits_[index / 64] >> (index % 64)) & 1;
+	}
 
+	std::vector<std::uint64_t> prime_sieve::primes() const {
+		std::vector<std::uint64_t> primes {};
+		primes.reserve(count_);
+		for_each_prime([&](const std::uint64_t p) { primes.push_back(p); });
+		return primes;
+	}
+
+	spf_table::spf_table(const std::uint32_t limit)
+		: limit_(limit), spf_(static_cast<std::size_t>(limit) + 1, 0), cofactor_(static_cast<std::size_t>(limit) + 1, 0) {
+		for (std::uint64_t i = 2; i <= limit; i++) {
+			if (spf_[i] == 0) {
+				spf_[i] = static_cast<std::uint32_t>(i);
+				cofactor_[i] = 1;
+				primes_.push_back(static_cast<std::uint32_t>(i));
+			}
+			// Every composite i*p is reached once, from its largest proper divisor i.
+			for (const std::uint32_t prime : primes_) {
+				const std::uint64_t multiple = i * prime;
+				if (prime > spf_[i] || multiple > limit) {
+					break;
+				}
+				spf_[multiple] = prime;
+				cofactor_[multiple] = static_cast<std::uint32_t>(i);
+			}
+		}
+	}
+
+	namespace {
+		template<modular_width T>
+		bool miller_rabin(const T n, const std::span<const std::uint64_t> witnesses) {
+			const modular_arithmetic<T> arithmetic(n);
+			int twos = 0;
+			T odd_part = n - 1;
+			while (odd_part % 2 == 0) {
+				odd_part >>= 1;
+				twos++;
+			}
+			const T one = arithmetic.one();
+			const T minus_one = arithmetic.sub(0, one);
+
+			for (const std::uint64_t witness : witnesses) {
+				const T a = static_cast<T>(witness % n);
+				if (a == 0) {
+					continue;
+				}
+				T x = arithmetic.pow(arithmetic.to_form(a), odd_part);
+				if (x == one || x == minus_one) {
+					continue;
+				}
+				bool composite = true;
+				for (int i = 1; i < twos && composite; i++) {
+					x = arithmetic.mul(x, x);
+					composite = x != minus_one;
+				}
+				if (composite) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr std::array<std::uint64_t, 15> primes_below_50 {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+	}
+
+	template<modular_width T>
+	bool is_prime(const T n) {
+		if (n < 2) {
+			return false;
+		}
+		for (const std::uint64_t p : primes_below_50) {
+			if (n % p == 0) {
+				return n == p;
+			}
+		}
+		if (n < 53 * 53) {
+			return true;
+		}
+		// Narrower widths have cheaper arithmetic and smaller witness sets.
+		if constexpr (sizeof(T) > 8) {
+			if (n >> 64 == 0) {
+				return is_prime(static_cast<std::uint64_t>(n));
+			}
+		}
+		if constexpr (sizeof(T) > 4) {
+			if (n >> 32 == 0) {
+				return is_prime(static_cast<std::uint32_t>(n));
+			}
+		}
+
+		if constexpr (sizeof(T) == 4) {
+			constexpr std::array<std::uint64_t, 3> witnesses {2, 7, 61};
+			return miller_rabin(n, std::span(witnesses));
+		} else if constexpr (sizeof(T) == 8) {
+			// Jim Sinclair's seven bases cover every 64-bit n.
+			constexpr std::array<std::uint64_t, 7> witnesses {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+			return miller_rabin(n, std::span(witnesses));
+		} else {
+			// The first 13 prime bases are proven below 3.3e24; past that the
+			// first 20 give a probable prime with no known counterexample.
+			constexpr std::array<std::uint64_t, 20> witnesses {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71};
+			const T proven_bound = static_cast<T>(3317044064679887) * 1000000000 + 385961981;
+			return miller_rabin(n, std::span(witnesses).first(n < proven_bound ? 13 : 20));
+		}
+	}
+
+	template<modular_width T>
+	T pollard_brent(const T n) {
+		if (n % 2 == 0) {
+			return 2;
+		}
+		constexpr T batch = 128;
+		// Everything stays in the arithmetic's residue form; gcds are unaffected
+		// because the Montgomery radix is coprime to n.
+		const modular_arithmetic<T> arithmetic(n);
+
+		for (T c = 1; ; c++) {
+			const T increment = arithmetic.to_form(c);
+			const auto step = [&](const T x) { return arithmetic.add(arithmetic.mul(x, x), increment); };
+			T y = arithmetic.to_form(2);
+			T x = y;
+			T saved_y = y;
+			T product = arithmetic.one();
+			T divisor = 1;
+
+			for (T cycle = 1; divisor == 1; cycle *= 2) {
+				x = y;
+				for (T i = 0; i < cycle; i++) {
+					y = step(y);
+				}
+				for (T done = 0; done < cycle && divisor == 1; done += batch) {
+					saved_y = y;
+					for (T i = 0; i < std::min(batch, cycle - done); i++) {
+						y = step(y);
+						product = arithmetic.mul(product, x > y ? x - y : y - x);
+					}
+					divisor = detail::binary_gcd(product, n);
+				}
+			}
+
+			// The batch overshot and multiplied in n itself, so replay it one step at a time.
+			if (divisor == n) {
+				do {
+					saved_y = step(saved_y);
+					divisor = detail::binary_gcd(x > saved_y ? x - saved_y : saved_y - x, n);
+				} while (divisor == 1);
+			}
+			if (divisor != n) {
+				return divisor;
+			}
+		}
+	}
+
+	namespace {
+		template<modular_width T>
+		void factorize_into(const T n, basic_factorization<T> &result) {
+			if (n == 1) {
+				return;
+			}
+			if constexpr (sizeof(T) > 8) {
+				if (n >> 64 == 0) {
+					for (const auto &[prime, exponent] : factorize(static_cast<std::uint64_t>(n))) {
+						result.add(prime, exponent);
+					}
+					return;
+				}
+			}
+			if (is_prime(n)) {
+				result.add(n);
+				return;
+			}
+			const T divisor = pollard_brent(n);
+			factorize_into(divisor, result);
+			factorize_into(n / divisor, result);
+		}
+	}
+
+	template<modular_width T>
+	basic_factorization<T> factorize(T n) {
+		basic_factorization<T> result {};
+		if (n < 2) {
+			return result;
+		}
+
+		// Pollard's rho is poor at finding tiny factors, so strip those first.
+		for (const std::uint64_t p : primes_below_50) {
+			while (n % p == 0) {
+				result.add(static_cast<T>(p));
+				n /= p;
+			}
+		}
+		factorize_into(n, result);
 		return result;
 	}
+
+	template bool is_prime<std::uint32_t>(std::uint32_t);
+	template bool is_prime<std::uint64_t>(std::uint64_t);
+	template bool is_prime<uint128_t>(uint128_t);
+	template std::uint32_t pollard_brent<std::uint32_t>(std::uint32_t);
+	template std::uint64_t pollard_brent<std::uint64_t>(std::uint64_t);
+	template uint128_t pollard_brent<uint128_t>(uint128_t);
+	template basic_factorization<std::uint32_t> factorize<std::uint32_t>(std::uint32_t);
+	template basic_factorization<std::uint64_t> factorize<std::uint64_t>(std::uint64_t);
+	template basic_factorization<uint128_t> factorize<uint128_t>(uint128_t);
+
+	namespace {
+		// One turn of the mod-210 wheel: the 48 residues coprime to 2*3*5*7,
+		// shifted to start at 11 so the first turn skips 1.
+		constexpr std::array<std::uint32_t, 48> wheel_210_offsets {
+			11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71,
+			73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 121, 127, 131, 137, 139, 143,
+			149, 151, 157, 163, 167, 169, 173, 179, 181, 187, 191, 193, 197, 199, 209, 211
+		};
+
+		// Every wheel candidate up to sqrt(2^32) with the constants for a
+		// division-free divisibility test: d divides n exactly when
+		// n * d^-1 mod 2^32 <= (2^32 - 1) / d. Laid out as structure-of-arrays,
+		// one wheel turn of 48 entries after another.
+		struct wheel_divisor_table {
+			static constexpr std::size_t turns = 65536 / 210 + 1;
+			std::array<std::uint32_t, turns * 48> divisors {};
+			std::array<std::uint32_t, turns * 48> inverses {};
+			std::array<std::uint32_t, turns * 48> limits {};
+
+			constexpr wheel_divisor_table() {
+				for (std::size_t turn = 0; turn < turns; turn++) {
+					for (std::size_t lane = 0; lane < wheel_210_offsets.size(); lane++) {
+						const std::size_t index = turn * wheel_210_offsets.size() + lane;
+						const auto d = static_cast<std::uint32_t>(210 * turn + wheel_210_offsets[lane]);
+						// (3d) xor 2 is d^-1 to 5 bits; Newton's iteration doubles that each round.
+						std::uint32_t inverse = (3 * d) ^ 2;
+						for (int i = 0; i < 3; i++) {
+							inverse *= 2 - d * inverse;
+						}
+						divisors[index] = d;
+						inverses[index] = inverse;
+						limits[index] = std::numeric_limits<std::uint32_t>::max() / d;
+					}
+				}
+			}
+		};
+
+		constexpr wheel_divisor_table wheel_divisors {};
+
+		// Bit i is set when the i-th divisor of the turn divides n.
+		using divisibility_kernel = std::uint64_t (*)(std::uint32_t n, const std::uint32_t *inverses, const std::uint32_t *limits);
+
+		std::uint64_t divisible_lanes_scalar(const std::uint32_t n, const std::uint32_t *inverses, const std::uint32_t *limits) {
+			std::uint64_t mask = 0;
+			for (std::size_t lane = 0; lane < wheel_210_offsets.size(); lane++) {
+				mask |= static_cast<std::uint64_t>(n * inverses[lane] <= limits[lane]) << lane;
+			}
+			return mask;
+		}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		// Eight lanes per step; AVX2 has no unsigned compare, so q <= limit is
+		// tested as min(q, limit) == q.
+		__attribute__((target("avx2")))
+		std::uint64_t divisible_lanes_avx2(const std::uint32_t n, const std::uint32_t *inverses, const std::uint32_t *limits) {
+			const __m256i dividend = _mm256_set1_epi32(static_cast<int>(n));
+			std::uint64_t mask = 0;
+			for (std::size_t group = 0; group < wheel_210_offsets.size(); group += 8) {
+				const __m256i inverse = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(inverses + group));
+				const __m256i limit = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(limits + group));
+				const __m256i quotient = _mm256_mullo_epi32(dividend, inverse);
+				const __m256i divisible = _mm256_cmpeq_epi32(_mm256_min_epu32(quotient, limit), quotient);
+				mask |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(divisible)))) << group;
+			}
+			return mask;
+		}
+#endif
+
+		divisibility_kernel select_divisibility_kernel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+			if (__builtin_cpu_supports("avx2")) {
+				return divisible_lanes_avx2;
+			}
+#endif
+			return divisible_lanes_scalar;
+		}
+	}
+
+	basic_factorization<std::uint32_t> trial_division_factorize(std::uint32_t n) {
+		static const divisibility_kernel divisible_lanes = select_divisibility_kernel();
+		basic_factorization<std::uint32_t> result {};
+		if (n < 2) {
+			return result;
+		}
+
+		for (const std::uint32_t p : {2U, 3U, 5U, 7U}) {
+			while (n % p == 0) {
+				result.add(p);
+				n /= p;
+			}
+		}
+
+		// A whole wheel turn is tested at once; only the flagged divisors are
+		// then divided out, in increasing order.
+		constexpr std::size_t turn_size = wheel_210_offsets.size();
+		for (std::size_t turn = 0; turn < wheel_divisor_table::turns; turn++) {
+			const std::uint64_t first = wheel_divisors.divisors[turn * turn_size];
+			if (first * first > n) {
+				break;
+			}
+			const std::size_t offset = turn * turn_size;
+			for (std::uint64_t hits = divisible_lanes(n, &wheel_divisors.inverses[offset], &wheel_divisors.limits[offset]); hits != 0; hits &= hits - 1) {
+				const std::uint32_t divisor = wheel_divisors.divisors[offset + std::countr_zero(hits)];
+				while (n % divisor == 0) {
+					result.add(divisor);
+					n /= divisor;
+				}
+			}
+		}
+
+		if (n != 1) {
+			result.add(n);
+		}
+		return result;
+	}
+
+	basic_factorization<int> prime_count_map(const int number, const spf_table *accelerator) {
+		basic_factorization<int> result {};
+
+		if (number < 2) {
+			return result;
+		}
+
+		if (accelerator != nullptr && static_cast<std::uint32_t>(number) <= accelerator->limit()) {
+			accelerator->for_each_prime_factor(number, [&](const std::uint32_t prime, const int exponent) {
+				result.add(static_cast<int>(prime), exponent);
+			});
+			return result;
+		}
+
+		// Past 2^24 Pollard's rho beats walking the ~1000 wheel candidates below sqrt(number).
+		if (number > (1 << 24)) {
+			for (const auto &[prime, exponent] : factorize(static_cast<std::uint32_t>(number))) {
+				result.add(static_cast<int>(prime), exponent);
+			}
+			return result;
+		}
+
+		for (const auto &[prime, exponent] : trial_division_factorize(static_cast<std::uint32_t>(number))) {
+			result.add(static_cast<int>(prime), exponent);
+		}
+
+		return result;
+	}
+
+	namespace {
+		// The route prime_count_map takes, widened to 64 bits.
+		factorization factorize_by_size(const std::uint64_t n) {
+			if (n >> 32 != 0) {
+				return factorize(n);
+			}
+			const auto narrow = static_cast<std::uint32_t>(n);
+			factorization result {};
+			for (const auto &[prime, exponent] : narrow > (1U << 24) ? factorize(narrow) : trial_division_factorize(narrow)) {
+				result.add(prime, exponent);
+			}
+			return result;
+		}
+	}
+
+	void factorize_batch(const std::span<const std::uint64_t> numbers, factorization_batch &output, unsigned threads) {
+		// Each chunk is factorized into its own CSR buffers, which are then
+		// stitched together in input order.
+		constexpr std::size_t numbers_per_chunk = 1024;
+		const std::size_t chunk_count = (numbers.size() + numbers_per_chunk - 1) / numbers_per_chunk;
+		std::vector<factorization_batch> chunks(chunk_count);
+		if (threads == 0) {
+			threads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		threads = static_cast<unsigned>(std::min<std::size_t>(threads, chunk_count));
+
+		std::atomic<std::size_t> cursor {0};
+		std::exception_ptr failure {};
+		std::mutex failure_mtx;
+
+		auto worker = [&] {
+			try {
+				for (std::size_t chunk = cursor++; chunk < chunk_count; chunk = cursor++) {
+					factorization_batch &local = chunks[chunk];
+					const std::size_t end = std::min(numbers.size(), (chunk + 1) * numbers_per_chunk);
+					for (std::size_t i = chunk * numbers_per_chunk; i < end; i++) {
+						for (const auto &[prime, exponent] : factorize_by_size(numbers[i])) {
+							local.primes.push_back(prime);
+							local.exponents.push_back(static_cast<std::uint8_t>(exponent));
+						}
+						local.offsets.push_back(local.primes.size());
+					}
+				}
+			} catch (...) {
+				cursor = chunk_count;
+				std::lock_guard lock(failure_mtx);
+				if (!failure) {
+					failure = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> workers {};
+		for (unsigned t = 1; t < threads; t++) {
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (std::thread &thread : workers) {
+			thread.join();
+		}
+		if (failure) {
+			std::rethrow_exception(failure);
+		}
+
+		std::size_t total = 0;
+		for (const factorization_batch &chunk : chunks) {
+			total += chunk.primes.size();
+		}
+		output.offsets.assign(1, 0);
+		output.offsets.reserve(numbers.size() + 1);
+		output.primes.clear();
+		output.primes.reserve(total);
+		output.exponents.clear();
+		output.exponents.reserve(total);
+		for (const factorization_batch &chunk : chunks) {
+			const std::size_t base = output.primes.size();
+			for (std::size_t i = 1; i < chunk.offsets.size(); i++) {
+				output.offsets.push_back(base + chunk.offsets[i]);
+			}
+			output.primes.insert(output.primes.end(), chunk.primes.begin(), chunk.primes.end());
+			output.exponents.insert(output.exponents.end(), chunk.exponents.begin(), chunk.exponents.end());
+		}
+	}
 }
@@ -1,6 +1,565 @@
 #pragma once
 #include "precompile_header.h"
+#include "std_extensions.h"
+#include "montgomery.h"
 
 namespace utils {
-	std::map<int, int> prime_count_map(int number);
-}
\ No newline at end of file
+
+	// Largest integer r with r*r <= n.
+	std::uint64_t isqrt(std::uint64_t n);
+
+	// Most distinct primes any value of T can have: the length of the longest
+	// primorial 2*3*5*7*... that still fits in T. 15 for 64-bit integers.
+	template<typename T>
+	constexpr std::size_t max_distinct_prime_factors() {
+		// numeric_limits only knows __int128 in GNU mode, so unsigned widths use ~0.
+		constexpr T max_value = T(-1) > T(0) ? static_cast<T>(~T {0}) : std::numeric_limits<T>::max();
+		T primorial = 1;
+		std::size_t count = 0;
+		for (T candidate = 2; ; candidate++) {
+			bool is_prime = true;
+			for (T divisor = 2; divisor * divisor <= candidate; divisor++) {
+				is_prime = is_prime && candidate % divisor != 0;
+			}
+			if (!is_prime) {
+				continue;
+			}
+			if (primorial > max_value / candidate) {
+				return count;
+			}
+			primorial *= candidate;
+			count++;
+		}
+	}
+
+	// Prime factorization held inline as (prime, exponent) pairs sorted by
+	// prime. Capacity is the most distinct primes a T can have, so it never
+	// allocates and works in constant expressions. Iterates, compares and
+	// prints like the std::map<prime, exponent> it replaces.
+	template<typename T>
+	class basic_factorization {
+	public:
+		using value_type = std::pair<T, int>;
+		using const_iterator = const value_type *;
+		static constexpr std::size_t capacity = max_distinct_prime_factors<T>();
+
+		// Multiply prime^exponent into the factorization.
+		constexpr void add(const T prime, const int exponent = 1) {
+			value_type *position = std::ranges::lower_bound(begin_mut(), end_mut(), prime, {}, &value_type::first);
+			if (position != end_mut() && position->first == prime) {
+				position->second += exponent;
+				return;
+			}
+			if (size_ == capacity) {
+				throw std::length_error("Too many distinct primes for the factorization capacity.");
+			}
+			std::move_backward(position, end_mut(), end_mut() + 1);
+			*position = {prime, exponent};
+			size_++;
+		}
+
+		[[nodiscard]] constexpr const_iterator begin() const { return factors_.data(); }
+		[[nodiscard]] constexpr const_iterator end() const { return factors_.data() + size_; }
+		[[nodiscard]] constexpr std::size_t size() const { return size_; }
+		[[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+		[[nodiscard]] constexpr const value_type &front() const { return factors_[0]; }
+		[[nodiscard]] constexpr const value_type &back() const { return factors_[size_ - 1]; }
+
+		[[nodiscard]] constexpr const_iterator find(const T prime) const {
+			const const_iterator position = std::ranges::lower_bound(begin(), end(), prime, {}, &value_type::first);
+			return position != end() && position->first == prime ? position : end();
+		}
+
+		[[nodiscard]] constexpr bool contains(const T prime) const { return find(prime) != end(); }
+
+		[[nodiscard]] constexpr std::size_t count(const T prime) const { return contains(prime) ? 1 : 0; }
+
+		// Exponent of prime, throwing std::out_of_range when it is not a factor.
+		[[nodiscard]] constexpr int at(const T prime) const {
+			const const_iterator position = find(prime);
+			if (position == end()) {
+				throw std::out_of_range("Prime is not a factor.");
+			}
+			return position->second;
+		}
+
+		// Exponent of prime, zero when it is not a factor.
+		[[nodiscard]] constexpr int exponent_of(const T prime) const {
+			const const_iterator position = find(prime);
+			return position == end() ? 0 : position->second;
+		}
+
+		template<typename Key = T, typename Value = int>
+		[[nodiscard]] std::map<Key, Value> to_map() const {
+			std::map<Key, Value> result {};
+			for (const auto &[prime, exponent] : *this) {
+				result[static_cast<Key>(prime)] = static_cast<Value>(exponent);
+			}
+			return result;
+		}
+
+		friend constexpr bool operator==(const basic_factorization &lhs, const basic_factorization &rhs) {
+			return std::ranges::equal(lhs, rhs);
+		}
+
+		template<typename Key, typename Value>
+		friend bool operator==(const basic_factorization &lhs, const std::map<Key, Value> &rhs) {
+			return std::ranges::equal(lhs, rhs, [](const value_type &factor, const std::pair<const Key, Value> &entry) {
+				return factor.first == static_cast<T>(entry.first) && factor.second == static_cast<int>(entry.second);
+			});
+		}
+
+		friend std::ostream &operator<<(std::ostream &os, const basic_factorization &factors) {
+			os << "{";
+			for (const auto &[prime, exponent] : factors) {
+				os << prime << ": " << exponent << ", ";
+			}
+			os << "}";
+			return os;
+		}
+
+	private:
+		constexpr value_type *begin_mut() { return factors_.data(); }
+		constexpr value_type *end_mut() { return factors_.data() + size_; }
+
+		std::array<value_type, capacity> factors_ {};
+		std::size_t size_ {0};
+	};
+
+	using factorization = basic_factorization<std::uint64_t>;
+
+	namespace detail {
+		// Odd-only bit-packed sieve over [0, Limit) for constant evaluation,
+		// laid out like prime_sieve::odd_bits: bit i is set when 2*i + 1 is
+		// prime. Working on whole words keeps constant evaluation of 2^16 to
+		// about half a second per translation unit.
+		template<std::size_t Limit>
+		constexpr std::array<std::uint64_t, (Limit / 2 + 63) / 64> compile_time_odd_sieve() {
+			std::array<std::uint64_t, (Limit / 2 + 63) / 64> odd_bits {};
+			if constexpr (Limit < 2) {
+				return odd_bits;
+			}
+			// Mark composites, then flip: setting every bit up front costs as much as the sieve.
+			odd_bits[0] = 1;
+			for (std::size_t p = 3; p * p < Limit; p += 2) {
+				if (odd_bits[p / 2 / 64] >> (p / 2 % 64) & 1) {
+					continue;
+				}
+				for (std::size_t bit = p * p / 2; bit < Limit / 2; bit += p) {
+					odd_bits[bit / 64] |= std::uint64_t {1} << (bit % 64);
+				}
+			}
+			for (std::uint64_t &word : odd_bits) {
+				word = ~word;
+			}
+			if (Limit / 2 % 64 != 0) {
+				odd_bits.back() &= (std::uint64_t {1} << (Limit / 2 % 64)) - 1;
+			}
+			return odd_bits;
+		}
+	}
+
+	// Number of primes below Limit, computed at compile time.
+	template<std::size_t Limit>
+	inline constexpr std::size_t prime_count_below = [] {
+		std::size_t count = Limit > 2 ? 1 : 0;
+		for (const std::uint64_t word : detail::compile_time_odd_sieve<Limit>()) {
+			count += std::popcount(word);
+		}
+		return count;
+	}();
+
+	// The primes below Limit in increasing order, as a constant expression.
+	template<std::size_t Limit, typename T = std::uint32_t>
+	constexpr std::array<T, prime_count_below<Limit>> make_prime_table() {
+		std::array<T, prime_count_below<Limit>> primes {};
+		std::size_t count = 0;
+		if (Limit > 2) {
+			primes[count++] = 2;
+		}
+		const auto odd_bits = detail::compile_time_odd_sieve<Limit>();
+		for (std::size_t w = 0; w < odd_bits.size(); w++) {
+			for (std::uint64_t bits = odd_bits[w]; bits != 0; bits &= bits - 1) {
+				primes[count++] = static_cast<T>(2 * (64 * w + std::countr_zero(bits)) + 1);
+			}
+		}
+		return primes;
+	}
+
+	// Smallest prime factor of every n in [0, Limit], zero for 0 and 1.
+	template<std::size_t Limit, typename T = std::uint32_t>
+	constexpr std::array<T, Limit + 1> make_spf_table() {
+		std::array<T, Limit + 1> spf {};
+		for (std::size_t p = 2; p <= Limit; p++) {
+			if (spf[p] != 0) {
+				continue;
+			}
+			for (std::size_t multiple = p; multiple <= Limit; multiple += p) {
+				if (spf[multiple] == 0) {
+					spf[multiple] = static_cast<T>(p);
+				}
+			}
+		}
+		return spf;
+	}
+
+	// The 6542 primes below 2^16: every prime that can divide a 32-bit
+	// number below its square root. Generated once by make_prime_table in
+	// prime_utils.cpp, so including this header does not evaluate the sieve.
+	extern const std::array<std::uint32_t, 6542> small_primes;
+
+	// Trial division by 2, 3 and then the numbers 6k +- 1. Needs no prime
+	// table, so it costs nothing at compile time until a constant expression
+	// calls it. Meant for constant expressions and small inputs; factorize is
+	// far faster at run time for large ones.
+	template<typename T>
+	constexpr basic_factorization<T> factorize_constexpr(T n) {
+		basic_factorization<T> result {};
+		for (const T p : {T {2}, T {3}}) {
+			while (n % p == 0 && n > 1) {
+				result.add(p);
+				n /= p;
+			}
+		}
+		for (T divisor = 5, step = 2; divisor <= n / divisor; divisor += step, step = 6 - step) {
+			while (n % divisor == 0) {
+				result.add(divisor);
+				n /= divisor;
+			}
+		}
+		if (n > 1) {
+			result.add(n);
+		}
+		return result;
+	}
+
+	// Default sieve segment size: one L1 data cache worth of bits. Each bit
+	// stands for an odd number, so a segment covers 16 numbers per byte.
+	constexpr std::size_t default_sieve_segment_bytes = 32 * 1024;
+
+	namespace detail {
+		// Prime callbacks may return void (visit everything) or bool (false stops).
+		template<typename Callback>
+		bool invoke_prime_callback(Callback &callback, const std::uint64_t prime) {
+			if constexpr (std::is_same_v<std::invoke_result_t<Callback &, std::uint64_t>, bool>) {
+				return callback(prime);
+			} else {
+				callback(prime);
+				return true;
+			}
+		}
+	}
+
+	// One sieved window of odd numbers in bit-packed form. Bit i of words is
+	// set when first_odd + 2*i is prime. Bits outside the requested range are
+	// already cleared, and 2 is reported through contains_two since the
+	// storage holds odd numbers only.
+	struct prime_segment {
+		std::uint64_t first_odd;
+		std::span<const std::uint64_t> words;
+		bool contains_two;
+
+		template<typename Callback>
+		bool for_each_prime(Callback &&callback) const {
+			if (contains_two && !detail::invoke_prime_callback(callback, 2)) {
+				return false;
+			}
+			for (std::size_t w = 0; w < words.size(); w++) {
+				std::uint64_t bits = words[w];
+				while (bits != 0) {
+					const std::uint64_t prime = first_odd + 2 * (64 * w + std::countr_zero(bits));
+					if (!detail::invoke_prime_callback(callback, prime)) {
+						return false;
+					}
+					bits &= bits - 1;
+				}
+			}
+			return true;
+		}
+	};
+
+	// Segmented Sieve of Eratosthenes over [lo, hi]. Only the base primes up to
+	// sqrt(hi) are held in memory, so ranges around 1e12 and beyond cost a few
+	// hundred KiB. The callback returns false to stop early.
+	void for_each_prime_segment(
+		std::uint64_t lo,
+		std::uint64_t hi,
+		const std::function<bool(const prime_segment &)> &callback,
+		std::size_t segment_bytes = default_sieve_segment_bytes
+	);
+
+	// Visit every prime in [lo, hi] in increasing order.
+	template<typename Callback>
+	void for_each_prime(const std::uint64_t lo, const std::uint64_t hi, Callback &&callback) {
+		for_each_prime_segment(lo, hi, [&](const prime_segment &segment) {
+			return segment.for_each_prime(callback);
+		});
+	}
+
+	// Unbounded segmented sieve that produces one segment per call, starting
+	// at from. Base primes are added only as the segments reach their
+	// squares, so memory is one segment plus the primes up to sqrt of the
+	// current position.
+	class incremental_prime_sieve {
+	public:
+		explicit incremental_prime_sieve(std::uint64_t from = 2, std::size_t segment_bytes = default_sieve_segment_bytes);
+
+		// The segment's words stay valid until the next call.
+		prime_segment next_segment();
+
+	private:
+		std::uint64_t from_;
+		std::uint64_t first_low_;
+		std::uint64_t next_low_;
+		std::uint64_t base_bound_ {2};
+		std::vector<std::uint64_t> base_primes_ {};
+		std::vector<std::uint64_t> next_multiple_ {};
+		std::vector<std::uint64_t> words_;
+	};
+
+	namespace views {
+		// Lazy, unbounded input range over the primes >= from. The next
+		// segment is sieved only when iteration reaches it, so it composes with
+		// std::views::take_while, filter and friends at the cost of one segment
+		// of memory.
+		class prime_view : public std::ranges::view_interface<prime_view> {
+		public:
+			class iterator {
+			public:
+				using iterator_concept = std::input_iterator_tag;
+				using value_type = std::uint64_t;
+				using difference_type = std::ptrdiff_t;
+
+				iterator() = default;
+
+				explicit iterator(const std::uint64_t from) : cursor_(std::make_shared<cursor>(from)) {}
+
+				std::uint64_t operator*() const { return cursor_->primes[cursor_->position]; }
+
+				iterator &operator++() {
+					cursor_->advance();
+					return *this;
+				}
+
+				void operator++(int) { ++*this; }
+
+			private:
+				// Shared so copies of a single-pass iterator stay cheap.
+				struct cursor {
+					explicit cursor(const std::uint64_t from) : sieve(from) {
+						refill();
+					}
+
+					void advance() {
+						if (++position == primes.size()) {
+							refill();
+						}
+					}
+
+					void refill() {
+						primes.clear();
+						position = 0;
+						while (primes.empty()) {
+							sieve.next_segment().for_each_prime([&](const std::uint64_t p) { primes.push_back(p); });
+						}
+					}
+
+					incremental_prime_sieve sieve;
+					std::vector<std::uint64_t> primes {};
+					std::size_t position {0};
+				};
+
+				std::shared_ptr<cursor> cursor_ {};
+			};
+
+			prime_view() = default;
+
+			explicit prime_view(const std::uint64_t from) : from_(from) {}
+
+			[[nodiscard]] iterator begin() const { return iterator(from_); }
+
+			[[nodiscard]] std::unreachable_sentinel_t end() const { return {}; }
+
+		private:
+			std::uint64_t from_ {2};
+		};
+
+		inline prime_view primes(const std::uint64_t from = 2) {
+			return prime_view(from);
+		}
+	}
+
+	// Multi-threaded segmented sieve over [lo, hi]. Workers claim segments
+	// from a shared atomic cursor and sieve them against one base-prime list.
+	// The callback gets each segment's index alongside it and runs on the
+	// worker threads concurrently and in no particular order. threads == 0
+	// uses every hardware thread.
+	void for_each_prime_segment_parallel(
+		std::uint64_t lo,
+		std::uint64_t hi,
+		const std::function<void(std::uint64_t, const prime_segment &)> &callback,
+		unsigned threads = 0,
+		std::size_t segment_bytes = default_sieve_segment_bytes
+	);
+
+	// All primes in [lo, hi] in increasing order, sieved on threads workers.
+	std::vector<std::uint64_t> primes_in_range(std::uint64_t lo, std::uint64_t hi, unsigned threads = 0);
+
+	std::vector<std::uint64_t> primes_up_to(std::uint64_t limit);
+
+	// Number of primes <= x by Lucy_Hedgehog's dynamic programming over the
+	// O(sqrt x) distinct values of floor(x/k), in O(x^(3/4)) time and
+	// O(sqrt x) memory: seconds and about 50 MiB at 1e13. The widest step of
+	// each round is split across threads workers; 0 uses every hardware thread.
+	std::uint64_t prime_pi(std::uint64_t x, unsigned threads = 1);
+
+	// Sum of the primes <= x, computed like prime_pi. Exact for every 64-bit x.
+	uint128_t prime_sum(std::uint64_t x, unsigned threads = 1);
+
+	// Bit-packed odd-only prime table for [0, limit], built segment by segment.
+	// Uses limit/16 bytes, so 1e10 fits in roughly 600 MiB.
+	class prime_sieve {
+	public:
+		explicit prime_sieve(std::uint64_t limit, std::size_t segment_bytes = default_sieve_segment_bytes);
+
+		[[nodiscard]] std::uint64_t limit() const { return limit_; }
+
+		// Number of primes <= limit.
+		[[nodiscard]] std::size_t count() const { return count_; }
+
+		[[nodiscard]] bool is_prime(std::uint64_t n) const;
+
+		[[nodiscard]] std::vector<std::uint64_t> primes() const;
+
+		// The raw table: bit i is set when 2*i + 1 is prime.
+		[[nodiscard]] std::span<const std::uint64_t> odd_bits() const { return odd_bits_; }
+
+		template<typename Callback>
+		void for_each_prime(Callback &&callback) const {
+			const prime_segment all {1, odd_bits_, limit_ >= 2};
+			all.for_each_prime(callback);
+		}
+
+	private:
+		std::uint64_t limit_;
+		std::size_t count_ {0};
+		// Bit i is set when 2*i + 1 is prime.
+		std::vector<std::uint64_t> odd_bits_;
+	};
+
+	// Smallest-prime-factor table for [0, limit] built with a linear sieve, so
+	// every composite is written exactly once. Alongside each smallest prime
+	// the table keeps the cofactor n / spf(n), which lets any n <= limit be
+	// factorized in O(log n) steps without a single division. Costs 8 bytes
+	// per entry.
+	class spf_table {
+	public:
+		explicit spf_table(std::uint32_t limit);
+
+		[[nodiscard]] std::uint32_t limit() const { return limit_; }
+
+		// Zero for 0 and 1.
+		[[nodiscard]] std::uint32_t smallest_prime_factor(const std::uint32_t n) const { return spf_.at(n); }
+
+		[[nodiscard]] bool is_prime(const std::uint32_t n) const { return n >= 2 && spf_.at(n) == n; }
+
+		[[nodiscard]] const std::vector<std::uint32_t> &primes() const { return primes_; }
+
+		// Calls callback(prime, exponent) for each distinct prime of n in increasing order.
+		template<typename Callback>
+		void for_each_prime_factor(std::uint32_t n, Callback &&callback) const {
+			if (n > limit_) {
+				throw std::out_of_range("Number is above the spf_table limit.");
+			}
+			while (n > 1) {
+				const std::uint32_t prime = spf_[n];
+				int exponent = 0;
+				while (spf_[n] == prime) {
+					n = cofactor_[n];
+					exponent++;
+				}
+				callback(prime, exponent);
+			}
+		}
+
+	private:
+		std::uint32_t limit_;
+		std::vector<std::uint32_t> spf_;
+		std::vector<std::uint32_t> cofactor_;
+		std::vector<std::uint32_t> primes_;
+	};
+
+	// Miller-Rabin primality in the arithmetic of n's width. Deterministic for
+	// every n below 3.3e24: bases 2, 7 and 61 for 32-bit n, Jim Sinclair's seven
+	// bases for 64-bit n and the first 13 primes beyond. Larger 128-bit n are
+	// checked against the first 20 prime bases.
+	template<modular_width T>
+	bool is_prime(T n);
+
+	// Some non-trivial factor of an odd composite n, found with Brent's
+	// variant of Pollard's rho. Gcds are batched over 128 steps.
+	template<modular_width T>
+	T pollard_brent(T n);
+
+	// Full factorization of n. Expected cost is O(n^(1/4)) modular
+	// multiplications, microseconds for any 64-bit semiprime. 128-bit inputs
+	// work the same way but a product of two 64-bit primes takes minutes.
+	template<modular_width T>
+	basic_factorization<T> factorize(T n);
+
+	inline bool is_prime_u64(const std::uint64_t n) {
+		return is_prime(n);
+	}
+
+	inline factorization factorize_u64(const std::uint64_t n) {
+		return factorize(n);
+	}
+
+	// Sieve-free trial division over a mod-210 wheel, which skips multiples of
+	// 2, 3, 5 and 7. Each wheel turn of 48 candidates is tested with
+	// multiply-by-inverse divisibility checks, eight lanes at a time on AVX2
+	// when the CPU has it. The ~180 KiB inverse table is a constant
+	// expression, so it sits in read-only data and nothing is built at run
+	// time.
+	basic_factorization<std::uint32_t> trial_division_factorize(std::uint32_t n);
+
+	// Factorizations of a batch of numbers in compressed sparse row form: the
+	// factors of number i are primes[offsets[i]] up to primes[offsets[i + 1]],
+	// in increasing order, with the matching exponents. Reusing one batch
+	// across calls keeps its buffers allocated.
+	struct factorization_batch {
+		std::vector<std::size_t> offsets {0};
+		std::vector<std::uint64_t> primes {};
+		std::vector<std::uint8_t> exponents {};
+
+		[[nodiscard]] std::size_t size() const { return offsets.size() - 1; }
+
+		[[nodiscard]] std::span<const std::uint64_t> primes_of(const std::size_t i) const {
+			return std::span(primes).subspan(offsets.at(i), offsets.at(i + 1) - offsets[i]);
+		}
+
+		[[nodiscard]] std::span<const std::uint8_t> exponents_of(const std::size_t i) const {
+			return std::span(exponents).subspan(offsets.at(i), offsets.at(i + 1) - offsets[i]);
+		}
+
+		[[nodiscard]] factorization operator[](const std::size_t i) const {
+			factorization result {};
+			for (std::size_t j = offsets.at(i); j < offsets.at(i + 1); j++) {
+				result.add(primes[j], exponents[j]);
+			}
+			return result;
+		}
+	};
+
+	// Factorize every number into output, replacing its contents. Each number
+	// takes the cheapest route for its size: wheel trial division with the
+	// vectorized divisibility kernel below 2^24, 32-bit Pollard-Brent up to
+	// 2^32 and 64-bit Montgomery Pollard-Brent beyond. Chunks of the input
+	// are sharded over threads workers; 0 uses every hardware thread.
+	void factorize_batch(std::span<const std::uint64_t> numbers, factorization_batch &output, unsigned threads = 0);
+
+	// Prime factorization of number. Pass an spf_table to
+	// look numbers up instead of trial dividing. Without one, large numbers go
+	// through 32-bit factorize and the rest use trial_division_factorize.
+	basic_factorization<int> prime_count_map(int number, const spf_table *accelerator = nullptr);
+}
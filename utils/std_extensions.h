@@ -2,6 +2,18 @@
 
 namespace std {
 
+// iostreams have no overload for the GCC/Clang 128-bit integer extension.
+inline std::ostream &operator<<(std::ostream &os, unsigned __int128 value) {
+	char digits[40];
+	char *first = digits + sizeof(digits);
+	do {
+		*--first = static_cast<char>('0' + static_cast<int>(value % 10));
+		value /= 10;
+	} while (value != 0);
+	os.write(first, digits + sizeof(digits) - first);
+	return os;
+}
+
 template<typename T>
 std::ostream &operator<<(std::ostream &os, const std::set <T> &s) {
 	os << "{";
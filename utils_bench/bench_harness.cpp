@@ -0,0 +1,113 @@
+#include "bench_harness.h"
+
+namespace utils::bench {
+	namespace {
+		using clock = std::chrono::steady_clock;
+
+		double median(std::vector<double> values) {
+			const auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+			std::ranges::nth_element(values, middle);
+			if (values.size() % 2 == 1) {
+				return *middle;
+			}
+			return (*middle + *std::max_element(values.begin(), middle)) / 2;
+		}
+
+		// JSON string literal for s. Names are plain ASCII, so escaping quotes,
+		// backslashes and control characters is enough.
+		std::string json_string(const std::string &s) {
+			std::ostringstream out {};
+			out << '"';
+			for (const char c : s) {
+				if (c == '"' || c == '\\') {
+					out << '\\' << c;
+				} else if (static_cast<unsigned char>(c) < 0x20) {
+					out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+				} else {
+					out << c;
+				}
+			}
+			out << '"';
+			return out.str();
+		}
+	}
+
+	runner::runner(options settings) : settings_(std::move(settings)) {
+		if (settings_.samples == 0) {
+			throw std::invalid_argument("A benchmark needs at least one sample.");
+		}
+	}
+
+	void runner::run_batches(const std::string &name, const std::function<void(std::uint64_t)> &batch) {
+		if (name.find(settings_.filter) == std::string::npos) {
+			return;
+		}
+
+		// Warm up with doubling batches, which also measures the cost of a call.
+		std::uint64_t calls = 0;
+		std::uint64_t next_batch = 1;
+		const clock::time_point warmup_start = clock::now();
+		clock::duration elapsed {};
+		do {
+			batch(next_batch);
+			calls += next_batch;
+			next_batch *= 2;
+			elapsed = clock::now() - warmup_start;
+		} while (elapsed < settings_.warmup);
+
+		const double ns_per_call = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+			/ static_cast<double>(calls);
+		const auto iterations = static_cast<std::uint64_t>(std::max(
+			1.0, static_cast<double>(settings_.sample_time.count()) / std::max(ns_per_call, 1e-3)));
+
+		std::vector<double> samples {};
+		samples.reserve(settings_.samples);
+		for (std::size_t s = 0; s < settings_.samples; s++) {
+			const clock::time_point start = clock::now();
+			batch(iterations);
+			const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+			samples.push_back(static_cast<double>(ns) / static_cast<double>(iterations));
+		}
+
+		const double center = median(samples);
+		std::vector<double> deviations {};
+		deviations.reserve(samples.size());
+		for (const double sample : samples) {
+			deviations.push_back(std::abs(sample - center));
+		}
+		results_.push_back({name, iterations, samples.size(), center, median(deviations), std::ranges::min(samples)});
+	}
+
+	void runner::write_table(std::ostream &os) const {
+		std::size_t name_width = 4;
+		for (const result &r : results_) {
+			name_width = std::max(name_width, r.name.size());
+		}
+		os << std::left << std::setw(static_cast<int>(name_width)) << "name" << std::right
+		   << std::setw(16) << "median ns" << std::setw(12) << "mad ns" << std::setw(16) << "min ns"
+		   << std::setw(14) << "iterations" << "\n";
+		os << std::fixed << std::setprecision(1);
+		for (const result &r : results_) {
+			os << std::left << std::setw(static_cast<int>(name_width)) << r.name << std::right
+			   << std::setw(16) << r.median_ns << std::setw(12) << r.mad_ns << std::setw(16) << r.min_ns
+			   << std::setw(14) << r.iterations_per_sample << "\n";
+		}
+		os << std::defaultfloat;
+	}
+
+	void runner::write_json(std::ostream &os) const {
+		os << "{\n  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n  \"benchmarks\": [";
+		os << std::setprecision(6);
+		for (std::size_t i = 0; i < results_.size(); i++) {
+			const result &r = results_[i];
+			os << (i == 0 ? "\n" : ",\n")
+			   << "    {\"name\": " << json_string(r.name)
+			   << ", \"iterations_per_sample\": " << r.iterations_per_sample
+			   << ", \"samples\": " << r.samples
+			   << ", \"median_ns\": " << r.median_ns
+			   << ", \"mad_ns\": " << r.mad_ns
+			   << ", \"min_ns\": " << r.min_ns << "}";
+		}
+		os << "\n  ]\n}\n";
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "../utils/precompile_header.h"
+
+namespace utils::bench {
+
+	// Keep value, and everything computed to produce it, from being optimized away.
+	template<typename T>
+	void do_not_optimize(const T &value) {
+#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const T *sink = nullptr;
+		sink = &value;
+#endif
+	}
+
+	struct options {
+		// Time spent calling the operation before measuring, also used to
+		// estimate how many calls fill one sample.
+		std::chrono::nanoseconds warmup {std::chrono::milliseconds(50)};
+		// Wall time each sample aims for.
+		std::chrono::nanoseconds sample_time {std::chrono::milliseconds(10)};
+		std::size_t samples {15};
+		// Only benchmarks whose name contains this run.
+		std::string filter {};
+	};
+
+	// Timings of one benchmark, per call of the operation.
+	struct result {
+		std::string name;
+		std::uint64_t iterations_per_sample;
+		std::size_t samples;
+		double median_ns;
+		// Median absolute deviation of the samples from median_ns.
+		double mad_ns;
+		double min_ns;
+	};
+
+	// Runs each benchmark as warmup, then a fixed number of samples of an
+	// automatically scaled iteration count, and reports the median and
+	// median absolute deviation, which ignore the odd preempted sample.
+	class runner {
+	public:
+		explicit runner(options settings = {});
+
+		// Time op(), called back to back. Its return value, if any, is passed
+		// to do_not_optimize.
+		template<typename Op>
+		void run(const std::string &name, Op &&op) {
+			run_batches(name, [&](const std::uint64_t iterations) {
+				for (std::uint64_t i = 0; i < iterations; i++) {
+					if constexpr (std::is_void_v<std::invoke_result_t<Op &>>) {
+						op();
+					} else {
+						do_not_optimize(op());
+					}
+				}
+			});
+		}
+
+		[[nodiscard]] const std::vector<result> &results() const { return results_; }
+
+		// Aligned text table, one benchmark per line.
+		void write_table(std::ostream &os) const;
+
+		// {"benchmarks": [{"name": ..., "median_ns": ..., ...}, ...]}
+		void write_json(std::ostream &os) const;
+
+	private:
+		void run_batches(const std::string &name, const std::function<void(std::uint64_t)> &batch);
+
+		options settings_;
+		std::vector<result> results_ {};
+	};
+}
@@ -0,0 +1,184 @@
+#include "bench_harness.h"
+#include "../utils/prime_utils.h"
+#include "../utils/prime_cache.h"
+#include "../utils/modint.h"
+
+// Util-Bench: timings for prime_utils across input classes and widths.
+//
+//     Util-Bench [--filter TEXT] [--json PATH] [--quick]
+//
+// --json writes machine-readable results to PATH, or to stdout instead of
+// the table for "-".
+// --quick cuts warmup and sample time for a smoke run.
+
+namespace {
+	using utils::uint128_t;
+
+	constexpr std::size_t inputs_per_class = 256;
+
+	template<typename T>
+	T random_bits(std::mt19937_64 &random, const int bits) {
+		T value = 0;
+		for (int filled = 0; filled < bits; filled += 64) {
+			if constexpr (sizeof(T) > 8) {
+				value <<= 64;
+			}
+			value |= static_cast<T>(random());
+		}
+		const T top = T {1} << (bits - 1);
+		return (value & (top - 1)) | top;
+	}
+
+	template<typename T>
+	T random_prime(std::mt19937_64 &random, const int bits) {
+		for (;;) {
+			const T candidate = random_bits<T>(random, bits) | 1;
+			if (utils::is_prime(candidate)) {
+				return candidate;
+			}
+		}
+	}
+
+	// Numbers of about bits bits in each input class.
+	template<typename T>
+	std::map<std::string, std::vector<T>> input_classes(const int bits) {
+		std::mt19937_64 random(static_cast<std::uint64_t>(bits));
+		std::map<std::string, std::vector<T>> classes {};
+		for (std::size_t i = 0; i < inputs_per_class; i++) {
+			classes["random"].push_back(random_bits<T>(random, bits));
+			classes["prime"].push_back(random_prime<T>(random, bits));
+			classes["semiprime"].push_back(random_prime<T>(random, bits / 2) * random_prime<T>(random, bits - bits / 2));
+			// Products of primes below 100.
+			T smooth = 1;
+			for (;;) {
+				const auto p = static_cast<T>(utils::small_primes[random() % 25]);
+				if (smooth > (T {1} << (bits - 1)) / p) {
+					break;
+				}
+				smooth *= p;
+			}
+			classes["smooth"].push_back(smooth);
+		}
+		return classes;
+	}
+
+	// Cycle through inputs so the branch predictor cannot learn one value.
+	template<typename T, typename Fn>
+	auto cycling(const std::vector<T> &inputs, Fn fn) {
+		return [&inputs, fn, i = std::size_t {0}]() mutable {
+			i = i + 1 == inputs.size() ? 0 : i + 1;
+			return fn(inputs[i]);
+		};
+	}
+
+	template<typename T>
+	void bench_width(utils::bench::runner &runner, const std::string &width, const int bits) {
+		for (const auto &[input_class, inputs] : input_classes<T>(bits)) {
+			// Two 48-bit factors already take Pollard-Brent seconds, so wide
+			// semiprimes and random numbers are only tested for primality.
+			const bool factorable = bits <= 64 || input_class == "prime" || input_class == "smooth";
+			runner.run("is_prime/" + width + "/" + input_class, cycling(inputs, [](const T n) { return utils::is_prime(n); }));
+			if (factorable) {
+				runner.run("factorize/" + width + "/" + input_class, cycling(inputs, [](const T n) { return utils::factorize(n).size(); }));
+			}
+		}
+	}
+
+	void bench_small(utils::bench::runner &runner) {
+		std::mt19937_64 random(1);
+		std::vector<std::uint32_t> small {};
+		for (std::size_t i = 0; i < inputs_per_class; i++) {
+			small.push_back(static_cast<std::uint32_t>(random() % (1 << 24)));
+		}
+		runner.run("trial_division_factorize/u24/random", cycling(small, [](const std::uint32_t n) {
+			return utils::trial_division_factorize(n).size();
+		}));
+		runner.run("prime_count_map/u24/random", cycling(small, [](const std::uint32_t n) {
+			return utils::prime_count_map(static_cast<int>(n)).size();
+		}));
+		runner.run("factorize_constexpr/u24/random", cycling(small, [](const std::uint32_t n) {
+			return utils::factorize_constexpr(n).size();
+		}));
+
+		const utils::spf_table table(1 << 24);
+		runner.run("spf_table/u24/random", cycling(small, [&table](const std::uint32_t n) {
+			int factors = 0;
+			table.for_each_prime_factor(n, [&](std::uint32_t, int) { factors++; });
+			return factors;
+		}));
+	}
+
+	void bench_bulk(utils::bench::runner &runner) {
+		std::mt19937_64 random(2);
+		std::vector<std::uint64_t> batch(4096);
+		for (std::uint64_t &n : batch) {
+			n = random() >> (random() % 64);
+		}
+		utils::factorization_batch output {};
+		runner.run("factorize_batch/u64/4096 mixed", [&] {
+			utils::factorize_batch(batch, output, 1);
+			return output.primes.size();
+		});
+
+		runner.run("prime_sieve/1e7", [] { return utils::prime_sieve(10000000).count(); });
+		runner.run("prime_pi/1e10", [] { return utils::prime_pi(10000000000ULL); });
+
+		// The first use maps, or on a cold cache writes, the shared table, so
+		// reserve outside the timed loop.
+		utils::prime_table_cache &cache = utils::prime_table_cache::shared();
+		cache.reserve(10000000);
+		runner.run("prime_table_cache/count 1e7", [&cache] {
+			std::size_t count = 0;
+			cache.for_each_prime(0, 10000000, [&](std::uint64_t) { count++; });
+			return count;
+		});
+
+		using mint = utils::modint<18446744073709551557ULL>;
+		runner.run("modint/u64/pow", [x = mint(3)]() mutable {
+			x = x.pow(0xfedcba9876543210ULL);
+			return x.value();
+		});
+	}
+}
+
+int main(const int argc, char *argv[]) {
+	utils::bench::options settings {};
+	std::string json_path {};
+	for (int i = 1; i < argc; i++) {
+		const std::string argument = argv[i];
+		if (argument == "--filter" && i + 1 < argc) {
+			settings.filter = argv[++i];
+		} else if (argument == "--json" && i + 1 < argc) {
+			json_path = argv[++i];
+		} else if (argument == "--quick") {
+			settings.warmup = std::chrono::milliseconds(5);
+			settings.sample_time = std::chrono::milliseconds(1);
+			settings.samples = 5;
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--filter TEXT] [--json PATH] [--quick]\n";
+			return 2;
+		}
+	}
+
+	utils::bench::runner runner(settings);
+	bench_width<std::uint32_t>(runner, "u32", 32);
+	bench_width<std::uint64_t>(runner, "u64", 64);
+	bench_width<uint128_t>(runner, "u128", 96);
+	bench_small(runner);
+	bench_bulk(runner);
+
+	if (json_path == "-") {
+		runner.write_json(std::cout);
+		return 0;
+	}
+	runner.write_table(std::cout);
+	if (!json_path.empty()) {
+		std::ofstream out(json_path);
+		runner.write_json(out);
+		if (!out) {
+			std::cerr << "Could not write " << json_path << "\n";
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,66 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/arith_tables.h"
+#include "../utils/prime_utils.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Arithmetic function tables test suite.");
+
+TEST_CASE("Test arith_tables linear sieve.") {
+	constexpr std::uint32_t limit = 5000;
+
+	SUBCASE("Every table matches the factorization")
+	{
+		const utils::arith_tables tables(limit, {.phi = true, .mu = true, .sigma_k = 2, .divisor_count = true, .omega = true});
+		REQUIRE(tables.phi().size() == limit + 1);
+		CHECK(tables.phi()[0] == 0);
+		CHECK(tables.sigma()[0] == 0);
+		for (std::uint32_t n = 1; n <= limit; n++) {
+			std::uint64_t phi = n;
+			int mu = 1;
+			std::uint64_t sigma = 1;
+			std::uint64_t divisors = 1;
+			for (const auto &[prime, exponent] : utils::factorize(n)) {
+				phi = phi / prime * (prime - 1);
+				mu = exponent > 1 ? 0 : -mu;
+				std::uint64_t power_sum = 1;
+				std::uint64_t term = 1;
+				for (int e = 0; e < exponent; e++) {
+					term *= std::uint64_t {prime} * prime;
+					power_sum += term;
+				}
+				sigma *= power_sum;
+				divisors *= exponent + 1;
+			}
+			CHECK(tables.phi()[n] == phi);
+			CHECK(tables.mu()[n] == mu);
+			CHECK(tables.sigma()[n] == sigma);
+			CHECK(tables.divisor_count()[n] == divisors);
+			CHECK(tables.omega()[n] == utils::factorize(n).size());
+		}
+	}
+	SUBCASE("Only requested tables are filled")
+	{
+		const utils::arith_tables tables(limit, {.sigma_k = 0});
+		CHECK(tables.phi().empty());
+		CHECK(tables.omega().empty());
+		const utils::arith_tables divisors(limit, {.divisor_count = true});
+		CHECK(std::ranges::equal(tables.sigma().subspan(1), divisors.divisor_count().subspan(1)));
+		CHECK(utils::arith_tables(0, {.phi = true}).phi().size() == 1);
+	}
+	SUBCASE("File-backed tables")
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path()
+			/ ("arith_tables_test_" + std::to_string(std::random_device {}()) + ".bin");
+		{
+			const utils::arith_tables mapped(limit, {.phi = true, .mu = true, .backing_file = path});
+			const utils::arith_tables heap(limit, {.phi = true, .mu = true});
+			CHECK(std::filesystem::file_size(path) >= (limit + 1) * 5);
+			CHECK(std::ranges::equal(mapped.phi(), heap.phi()));
+			CHECK(std::ranges::equal(mapped.mu(), heap.mu()));
+		}
+		std::filesystem::remove(path);
+	}
+}
+
+TEST_SUITE_END;
@@ -0,0 +1,155 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/big_uint.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Big integer test suite.");
+
+TEST_CASE("Test big_uint arithmetic.") {
+	SUBCASE("Carries, borrows and products across limbs")
+	{
+		const utils::big_uint max_limb = ~std::uint64_t {0};
+		CHECK((max_limb + 1).to_string() == "18446744073709551616");
+		CHECK((max_limb + 1 - 1) == max_limb);
+		CHECK((max_limb * max_limb).to_string() == "340282366920938463426481119284349108225");
+		CHECK(utils::big_uint(0).is_zero());
+		CHECK(utils::big_uint(0).to_string() == "0");
+		CHECK_THROWS_AS((void)(utils::big_uint(1) - 2), std::underflow_error);
+		CHECK_THROWS_AS((void)utils::big_uint(-1), std::domain_error);
+	}
+	SUBCASE("Decimal round trip and ordering")
+	{
+		const std::string digits = "1234567890123456789012345678901234567890000000000000000000001";
+		const utils::big_uint value = utils::big_uint::from_string(digits);
+		CHECK(value.to_string() == digits);
+		CHECK(value.bit_width() == 200);
+		CHECK(value > utils::big_uint::from_string("999999999999999999999999999999"));
+		CHECK(utils::big_uint(12345).to_u64() == 12345);
+		CHECK_THROWS_AS((void)value.to_u64(), std::overflow_error);
+		CHECK_THROWS_AS((void)utils::big_uint::from_string("12a"), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Test big_uint Karatsuba, division and storage.") {
+	std::mt19937_64 random(23);
+	const auto random_value = [&](const std::size_t limbs) {
+		utils::big_uint value {};
+		for (std::size_t i = 0; i < limbs; i++) {
+			value = value * utils::big_uint(~std::uint64_t {0}) + utils::big_uint(random());
+		}
+		return value;
+	};
+	const auto residue = [](const utils::big_uint &value, const std::uint64_t modulus) { return value % modulus; };
+
+	SUBCASE("Products agree with residues and the square identity")
+	{
+		constexpr std::uint64_t prime = 18446744073709551557ULL;
+		for (const auto &[lhs_limbs, rhs_limbs] : std::vector<std::pair<std::size_t, std::size_t>> {{31, 31}, {32, 32}, {33, 95}, {200, 200}, {257, 64}, {1000, 999}}) {
+			const utils::big_uint lhs = random_value(lhs_limbs);
+			const utils::big_uint rhs = random_value(rhs_limbs);
+			const utils::big_uint product = lhs * rhs;
+			CHECK(residue(product, prime) == static_cast<std::uint64_t>(static_cast<utils::uint128_t>(residue(lhs, prime)) * residue(rhs, prime) % prime));
+			CHECK((lhs + rhs) * (lhs + rhs) == lhs * lhs + utils::big_uint(2) * product + rhs * rhs);
+		}
+	}
+	SUBCASE("Single-limb division")
+	{
+		const utils::big_uint value = random_value(40);
+		for (const std::uint64_t divisor : {1ULL, 2ULL, 10ULL, 10000000000000000000ULL, 18446744073709551557ULL, ~0ULL, 3ULL << 62}) {
+			const std::uint64_t remainder = value % divisor;
+			CHECK(remainder < divisor);
+			CHECK((value / divisor) * utils::big_uint(divisor) + utils::big_uint(remainder) == value);
+		}
+		CHECK(utils::big_uint(1000) / 7 == utils::big_uint(142));
+		CHECK(utils::big_uint(0) % 7 == 0);
+		CHECK_THROWS_AS((void)(utils::big_uint(5) / 0), std::domain_error);
+	}
+	SUBCASE("Decimal conversion of long values")
+	{
+		for (const std::size_t limbs : {1, 2, 5, 37, 300}) {
+			const utils::big_uint value = random_value(limbs);
+			std::string expected {};
+			for (utils::big_uint rest = value; !rest.is_zero(); rest = rest / 10) {
+				expected.push_back(static_cast<char>('0' + rest % 10));
+			}
+			std::ranges::reverse(expected);
+			CHECK(value.to_string() == expected);
+			CHECK(utils::big_uint::from_string(expected) == value);
+		}
+		CHECK(utils::big_uint::from_string("000000000000000000000000000000000000000042") == utils::big_uint(42));
+		CHECK(utils::big_uint::from_string("10000000000000000000000000000000000000000000000000000000000").to_string()
+			== "10000000000000000000000000000000000000000000000000000000000");
+	}
+	SUBCASE("Inline and heap storage survive copies and moves")
+	{
+		utils::big_uint value = 1;
+		for (int i = 0; i < 12; i++) {
+			value *= utils::big_uint(~std::uint64_t {0});
+			const utils::big_uint copy = value;
+			utils::big_uint moved = copy;
+			utils::big_uint target = random_value(6 - i / 2);
+			target = std::move(moved);
+			CHECK(target == value);
+			target = copy;
+			CHECK(target == value);
+			CHECK(copy.limbs().size() == static_cast<std::size_t>(i + 1));
+		}
+	}
+	SUBCASE("Small products and shrunk values use inline storage")
+	{
+		const auto stored_inline = [](const utils::big_uint &value) {
+			const auto *limbs = reinterpret_cast<const std::byte *>(value.limbs().data());
+			const auto *object = reinterpret_cast<const std::byte *>(&value);
+			return limbs >= object && limbs < object + sizeof(value);
+		};
+		const utils::big_uint max_u64(~std::uint64_t {0});
+		const utils::big_uint square = max_u64 * max_u64;
+		CHECK(square.limbs().size() == 2);
+		CHECK(stored_inline(square));
+
+		// Four-limb operands fill the stack scratch buffer exactly.
+		constexpr std::uint64_t prime = 18446744073709551557ULL;
+		const utils::big_uint lhs = random_value(4);
+		const utils::big_uint rhs = random_value(4);
+		const utils::big_uint product = lhs * rhs;
+		CHECK(product.limbs().size() >= 7);
+		CHECK_FALSE(stored_inline(product));
+		CHECK(residue(product, prime) == static_cast<std::uint64_t>(static_cast<utils::uint128_t>(residue(lhs, prime)) * residue(rhs, prime) % prime));
+
+		utils::big_uint shrunk = product;
+		shrunk -= product - utils::big_uint(12345);
+		CHECK(shrunk == utils::big_uint(12345));
+		CHECK(stored_inline(shrunk));
+		utils::big_uint divided = product;
+		for (int i = 0; i < 6; i++) {
+			divided = divided / ~std::uint64_t {0};
+		}
+		CHECK(divided.limbs().size() <= 2);
+		CHECK(stored_inline(divided));
+	}
+	SUBCASE("Prints through the std_extensions container printers")
+	{
+		std::ostringstream out {};
+		out << std::vector<utils::big_uint> {utils::big_uint(1), utils::big_uint::from_string("123456789012345678901234567890")};
+		CHECK(out.str() == "[1, 123456789012345678901234567890]");
+	}
+}
+
+TEST_CASE("Test big_uint product trees.") {
+	SUBCASE("Matches a running product")
+	{
+		std::vector<std::uint64_t> factors {};
+		utils::big_uint expected = 1;
+		std::mt19937_64 random(22);
+		for (int i = 0; i < 300; i++) {
+			factors.push_back(random() >> (random() % 64));
+			expected *= utils::big_uint(factors.back());
+			CHECK(utils::product_tree(factors) == expected);
+		}
+		CHECK(utils::product_tree({}) == utils::big_uint(1));
+		factors.push_back(0);
+		CHECK(utils::product_tree(factors).is_zero());
+	}
+}
+
+TEST_SUITE_END;
@@ -0,0 +1,95 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/digit_utils.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Digit utilities test suite.");
+
+TEST_CASE("Test digit counts.") {
+	SUBCASE("Evaluated at compile time")
+	{
+		static_assert(utils::digit_count(0u) == 1);
+		static_assert(utils::digit_count(std::uint8_t {255}) == 3);
+		static_assert(utils::digit_count(std::uint32_t {999999999}) == 9);
+		static_assert(utils::digit_count(std::uint32_t {1000000000}) == 10);
+		static_assert(utils::digit_count(~std::uint64_t {0}) == 20);
+		static_assert(utils::digit_count(~utils::uint128_t {0}) == 39);
+	}
+	SUBCASE("Every power of ten and its neighbours")
+	{
+		utils::uint128_t power = 1;
+		for (int digits = 1; digits <= 38; digits++) {
+			CHECK(utils::digit_count(power) == digits);
+			CHECK(utils::digit_count(power * 10 - 1) == digits);
+			if (power > 1) {
+				CHECK(utils::digit_count(power - 1) == digits - 1);
+			}
+			if (digits <= 19) {
+				CHECK(utils::digit_count(static_cast<std::uint64_t>(power)) == digits);
+				CHECK(utils::digit_count(static_cast<std::uint64_t>(power * 10 - 1)) == digits);
+			}
+			power *= 10;
+		}
+	}
+	SUBCASE("Matches std::to_string")
+	{
+		std::mt19937_64 random(20);
+		for (int i = 0; i < 10000; i++) {
+			const std::uint64_t n = random() >> (random() % 64);
+			CHECK(utils::digit_count(n) == static_cast<int>(std::to_string(n).size()));
+		}
+	}
+}
+
+TEST_CASE("Test digit reversal, palindromes and sums.") {
+	SUBCASE("Evaluated at compile time")
+	{
+		static_assert(utils::reverse_digits(12345u) == 54321);
+		static_assert(utils::reverse_digits(1200u) == 21);
+		static_assert(utils::is_palindrome(906609u));
+		static_assert(!utils::is_palindrome(906619u));
+		static_assert(utils::digit_sum(999999999u) == 81);
+	}
+	SUBCASE("Matches string round trips")
+	{
+		for (std::uint32_t n = 0; n < 100000; n++) {
+			const std::string digits = std::to_string(n);
+			std::string reversed = digits;
+			std::ranges::reverse(reversed);
+			CHECK(utils::is_palindrome(n) == (digits == reversed));
+			CHECK(utils::reverse_digits(n) == std::stoul(reversed));
+			int sum = 0;
+			for (const char c : digits) {
+				sum += c - '0';
+			}
+			CHECK(utils::digit_sum(n) == sum);
+		}
+	}
+	SUBCASE("128-bit values")
+	{
+		const utils::uint128_t palindrome = utils::uint128_t {999900665566009999ULL} * 1000000000000000000ULL + 999900665566009999ULL;
+		CHECK(utils::is_palindrome(palindrome));
+		CHECK(!utils::is_palindrome(palindrome + 1));
+		CHECK(utils::reverse_digits(palindrome) == palindrome);
+		CHECK(utils::digit_sum(~utils::uint128_t {0}) == 165);
+	}
+}
+
+TEST_CASE("Test digit views.") {
+	SUBCASE("Least significant digit first")
+	{
+		static_assert(std::ranges::forward_range<utils::digit_view<std::uint64_t>>);
+		static_assert(std::ranges::sized_range<utils::digit_view<std::uint64_t>>);
+		std::vector<int> digits {};
+		for (const int digit : utils::digit_view(1234u)) {
+			digits.push_back(digit);
+		}
+		CHECK(digits == std::vector<int> {4, 3, 2, 1});
+		CHECK(std::ranges::distance(utils::digit_view(0u)) == 1);
+		CHECK(*utils::digit_view(0u).begin() == 0);
+		CHECK(utils::digit_view(1000000u).size() == 7);
+		CHECK(std::ranges::count(utils::digit_view(~utils::uint128_t {0}), 1) == 3);
+	}
+}
+
+TEST_SUITE_END;
@@ -0,0 +1,88 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/fibonacci.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Fibonacci test suite.");
+
+TEST_CASE("Test fast-doubling Fibonacci numbers.") {
+	SUBCASE("Fixed widths up to their last representable term")
+	{
+		static_assert(utils::max_fibonacci_index<std::uint64_t>() == 93);
+		static_assert(utils::max_fibonacci_index<utils::uint128_t>() == 186);
+		std::uint64_t previous = 0;
+		std::uint64_t current = 1;
+		for (std::uint64_t n = 1; n <= 93; n++) {
+			CHECK(utils::fibonacci<std::uint64_t>(n) == current);
+			current = std::exchange(previous, current) + current;
+		}
+		CHECK(utils::fibonacci<std::uint64_t>(0) == 0);
+		CHECK(utils::fibonacci<std::uint64_t>(93) == 12200160415121876738ULL);
+		CHECK(utils::big_uint(utils::fibonacci<utils::uint128_t>(186)).to_string() == "332825110087067562321196029789634457848");
+		CHECK_THROWS_AS((void)utils::fibonacci<std::uint64_t>(94), std::overflow_error);
+		CHECK_THROWS_AS((void)utils::fibonacci<utils::uint128_t>(187), std::overflow_error);
+	}
+	SUBCASE("Arbitrary precision")
+	{
+		CHECK(utils::fibonacci<utils::big_uint>(300).to_string() == "222232244629420445529739893461909967206666939096499764990979600");
+		const std::string f_10000 = utils::fibonacci<utils::big_uint>(10000).to_string();
+		CHECK(f_10000.size() == 2090);
+		CHECK(f_10000.starts_with("33644764876431783266"));
+	}
+	SUBCASE("Modular")
+	{
+		CHECK(utils::fibonacci_mod(1000, 1000000007) == 517691607);
+		CHECK(utils::fibonacci_mod(1000, 18446744073709551557ULL) == 7463763643583319486ULL);
+		CHECK(utils::fibonacci_mod(1000, 1ULL << 40) == 856254603339ULL);
+		CHECK(utils::fibonacci_mod(1000000000000000000ULL, 1000000000039ULL) == 216541801503ULL);
+		CHECK(utils::fibonacci_mod(1000000000000000000ULL, 18446744073709551615ULL) == 10068635698145506875ULL);
+		CHECK(utils::fibonacci_mod(12345, 1) == 0);
+		CHECK_THROWS_AS((void)utils::fibonacci_mod(5, 0), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Test Pisano periods.") {
+	SUBCASE("Matches walking the sequence")
+	{
+		for (std::uint64_t m = 1; m <= 2000; m++) {
+			std::uint64_t period = 0;
+			std::uint64_t current = 0;
+			std::uint64_t next = 1 % m;
+			do {
+				current = std::exchange(next, (current + next) % m);
+				period++;
+			} while (current != 0 || next != 1 % m);
+			CHECK(utils::pisano_period(m) == period);
+		}
+	}
+	SUBCASE("Large composite moduli and huge indices")
+	{
+		CHECK(utils::pisano_period(1000000000) == 1500000000);
+		CHECK(utils::pisano_period(1000000000000ULL) == 1500000000000ULL);
+		CHECK(utils::fibonacci_mod_periodic(1000000000000000000ULL, 1000000000000ULL) == 299560546875ULL);
+		const utils::uint128_t two_to_100 = utils::uint128_t {1} << 100;
+		CHECK(utils::fibonacci_mod_periodic(two_to_100 + 12345, 1000) == 521);
+		CHECK(utils::fibonacci_mod_periodic((utils::uint128_t {1} << 127) - 1, 999999999989ULL * 2) == 1734975969341ULL);
+		CHECK_THROWS_AS((void)utils::pisano_period(0), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Test Fibonacci sums.") {
+	SUBCASE("Prefix sums")
+	{
+		CHECK(utils::fibonacci_prefix_sum<std::uint64_t>(10) == 143);
+		CHECK(utils::fibonacci_prefix_sum<std::uint64_t>(91) == utils::fibonacci<std::uint64_t>(93) - 1);
+		CHECK_THROWS_AS((void)utils::fibonacci_prefix_sum<std::uint64_t>(92), std::overflow_error);
+	}
+	SUBCASE("Even terms")
+	{
+		CHECK(utils::even_fibonacci_sum<std::uint64_t>(1) == 0);
+		CHECK(utils::even_fibonacci_sum<std::uint64_t>(4000000) == 4613732);
+		const utils::uint128_t limit = static_cast<utils::uint128_t>(1000000000000000ULL) * 1000000000000000ULL;
+		CHECK(utils::big_uint(utils::even_fibonacci_sum(limit)).to_string() == "727244555616386341839153320976");
+		CHECK(utils::even_fibonacci_sum(utils::big_uint(limit)).to_string() == "727244555616386341839153320976");
+		CHECK_NOTHROW((void)utils::even_fibonacci_sum(~std::uint64_t {0}));
+	}
+}
+
+TEST_SUITE_END;
@@ -0,0 +1,91 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/modint.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Modint test suite.");
+
+namespace {
+	using mint = utils::modint<1000000007>;
+
+	// Reference result with a 128-bit remainder.
+	std::uint64_t mul_mod(const std::uint64_t a, const std::uint64_t b, const std::uint64_t mod) {
+		return static_cast<std::uint64_t>(static_cast<utils::uint128_t>(a) * b % mod);
+	}
+
+	template<typename Modint>
+	void check_against_remainders(const std::uint64_t mod) {
+		std::mt19937_64 random(mod);
+		for (int i = 0; i < 2000; i++) {
+			const std::uint64_t a = random();
+			const std::uint64_t b = random();
+			CHECK((Modint(a) * Modint(b)).value() == mul_mod(a % mod, b % mod, mod));
+			CHECK((Modint(a) + Modint(b)).value() == (static_cast<utils::uint128_t>(a % mod) + b % mod) % mod);
+			CHECK((Modint(a) - Modint(b)).value() == (static_cast<utils::uint128_t>(a % mod) + mod - b % mod) % mod);
+		}
+	}
+}
+
+TEST_CASE("Test compile-time modint.") {
+	SUBCASE("Constant-evaluated arithmetic")
+	{
+		static_assert((mint(1000000006) + mint(5)).value() == 4);
+		static_assert((mint(3) - mint(5)).value() == 1000000005);
+		static_assert(mint(-1).value() == 1000000006);
+		static_assert(mint(2).pow(1000000006) == mint(1));
+		static_assert((mint(3).inverse() * mint(3)).value() == 1);
+		static_assert((mint(10) / mint(4) * mint(4)).value() == 10);
+		static_assert(utils::modint<1ULL << 40>(-1).value() == (1ULL << 40) - 1);
+		static_assert(utils::modint<1>(12345).value() == 0);
+	}
+	SUBCASE("Odd, even and 64-bit moduli match 128-bit remainders")
+	{
+		check_against_remainders<mint>(1000000007);
+		check_against_remainders<utils::modint<1ULL << 32>>(1ULL << 32);
+		check_against_remainders<utils::modint<1000000000000000000ULL>>(1000000000000000000ULL);
+		check_against_remainders<utils::modint<18446744073709551557ULL>>(18446744073709551557ULL);
+	}
+	SUBCASE("Inverses need a coprime value")
+	{
+		using even = utils::modint<1000000>;
+		CHECK((even(999999).inverse() * even(999999)).value() == 1);
+		CHECK_THROWS_AS((void)even(10).inverse(), std::invalid_argument);
+		CHECK_THROWS_AS((void)(mint(1) / mint(0)), std::invalid_argument);
+		std::ostringstream printed {};
+		printed << mint(-2);
+		CHECK(printed.str() == "1000000005");
+	}
+}
+
+TEST_CASE("Test dynamic_modint.") {
+	SUBCASE("Runtime moduli of either parity")
+	{
+		using dint = utils::dynamic_modint<>;
+		dint::set_mod(998244353);
+		CHECK(dint::mod() == 998244353);
+		CHECK(dint(3).pow(998244352) == dint(1));
+		check_against_remainders<dint>(998244353);
+
+		dint::set_mod(600851475144ULL);
+		CHECK(dint(-5).value() == 600851475139ULL);
+		check_against_remainders<dint>(600851475144ULL);
+		CHECK_THROWS_AS((void)dint(6).inverse(), std::invalid_argument);
+		CHECK_THROWS_AS(dint::set_mod(0), std::invalid_argument);
+	}
+	SUBCASE("Batch inversion")
+	{
+		using dint = utils::dynamic_modint<1>;
+		dint::set_mod(1000000);
+		std::vector<dint> values {1, 3, 7, 999999, 123457};
+		const std::vector<dint> original = values;
+		utils::batch_invert(std::span(values));
+		for (std::size_t i = 0; i < values.size(); i++) {
+			CHECK(values[i] == original[i].inverse());
+		}
+		std::vector<dint> not_coprime {3, 4};
+		CHECK_THROWS_AS(utils::batch_invert(std::span(not_coprime)), std::invalid_argument);
+		CHECK(not_coprime == std::vector<dint> {3, 4});
+	}
+}
+
+TEST_SUITE_END;
@@ -0,0 +1,46 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/montgomery.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Montgomery arithmetic test suite.");
+
+TEST_CASE("Test montgomery multiplication.") {
+	SUBCASE("64-bit matches a 128-bit remainder")
+	{
+		const std::uint64_t mod = 18446744073709551557ULL;
+		const utils::montgomery<std::uint64_t> arithmetic(mod);
+		bool all_match = true;
+		std::uint64_t a = 123456789;
+		std::uint64_t b = 987654321987654321ULL;
+		for (int i = 0; i < 1000; i++) {
+			const std::uint64_t expected = static_cast<std::uint64_t>(static_cast<utils::uint128_t>(a) * b % mod);
+			const std::uint64_t product = arithmetic.from_form(arithmetic.mul(arithmetic.to_form(a), arithmetic.to_form(b)));
+			all_match = all_match && product == expected;
+			a = a * 6364136223846793005ULL + 1442695040888963407ULL;
+			b ^= a >> 7;
+		}
+		CHECK(all_match);
+		CHECK(arithmetic.from_form(arithmetic.to_form(mod - 1)) == mod - 1);
+	}
+	SUBCASE("128-bit Fermat test on 2^127 - 1")
+	{
+		const utils::uint128_t mersenne = (utils::uint128_t {1} << 127) - 1;
+		const utils::montgomery<utils::uint128_t> arithmetic(mersenne);
+		CHECK(arithmetic.from_form(arithmetic.pow(arithmetic.to_form(3), mersenne - 1)) == 1);
+		// 2^127 = 1 mod 2^127 - 1.
+		CHECK(arithmetic.from_form(arithmetic.pow(arithmetic.to_form(2), 127)) == 1);
+	}
+	SUBCASE("Even moduli are rejected")
+	{
+		CHECK_THROWS_AS(utils::montgomery<std::uint64_t>(10), std::invalid_argument);
+	}
+	SUBCASE("32-bit widths use a native product")
+	{
+		static_assert(std::same_as<utils::modular_arithmetic<std::uint32_t>, utils::native_modulus<std::uint32_t>>);
+		const utils::modular_arithmetic<std::uint32_t> arithmetic(4294967291U);
+		CHECK(arithmetic.pow(2U, 4294967290U) == 1);
+	}
+}
+
+TEST_SUITE_END;
@@ -0,0 +1,85 @@
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+#include "../doctest.h"
+#include "../utils/prime_cache.h"
+#include "../utils/utils.h"
+
+TEST_SUITE_BEGIN("Prime table cache test suite.");
+
+TEST_CASE("Test prime_table_cache persistence.") {
+	const std::filesystem::path path = std::filesystem::temp_directory_path()
+		/ ("prime_cache_test_" + std::to_string(std::random_device {}()) + ".bin");
+
+	SUBCASE("Creates, reopens and grows the file")
+	{
+		{
+			utils::prime_table_cache cache(path, 1000);
+			CHECK(cache.limit() == 1000);
+			CHECK(cache.is_prime(997));
+			CHECK_FALSE(cache.is_prime(999));
+		}
+		const auto written = std::filesystem::last_write_time(path);
+
+		utils::prime_table_cache reopened(path, 500);
+		CHECK(reopened.limit() == 1000);
+		CHECK(std::filesystem::last_write_time(path) == written);
+
+		// Past the limit the file at least doubles.
+		CHECK(reopened.is_prime(1000003));
+		CHECK(reopened.limit() == 1000003);
+		CHECK(reopened.is_prime(1000033));
+		CHECK(reopened.limit() == 2000006);
+
+		std::size_t count = 0;
+		reopened.for_each_prime(0, 1000000, [&](std::uint64_t) { count++; });
+		CHECK(count == 78498);
+
+		std::vector<std::uint64_t> window {};
+		reopened.for_each_prime(90, 128, [&](const std::uint64_t p) { window.push_back(p); });
+		CHECK(window == std::vector<std::uint64_t> {97, 101, 103, 107, 109, 113, 127});
+
+		for (const std::uint64_t hi : {0, 1, 2}) {
+			std::vector<std::uint64_t> tiny {};
+			reopened.for_each_prime(0, hi, [&](const std::uint64_t p) { tiny.push_back(p); });
+			CHECK(tiny == (hi == 2 ? std::vector<std::uint64_t> {2} : std::vector<std::uint64_t> {}));
+		}
+	}
+	SUBCASE("Stops growing at the maximum limit")
+	{
+		utils::prime_table_cache cache(path, 1000, 4096);
+		CHECK(cache.is_prime(1000000000000037));
+		CHECK_FALSE(cache.is_prime(1000000000000035));
+		CHECK(cache.limit() == 1000);
+
+		std::vector<std::uint64_t> straddling {};
+		cache.for_each_prime(4000, 4200, [&](const std::uint64_t p) { straddling.push_back(p); });
+		CHECK(straddling == utils::primes_in_range(4000, 4200));
+		CHECK(cache.limit() == 4096);
+
+		std::vector<std::uint64_t> far {};
+		cache.for_each_prime(1000000000000000, 1000000000000200, [&](const std::uint64_t p) { far.push_back(p); });
+		CHECK(far == utils::primes_in_range(1000000000000000, 1000000000000200));
+		CHECK(cache.limit() == 4096);
+
+		// Stopping inside the cached part skips the sieved part.
+		std::vector<std::uint64_t> stopped {};
+		cache.for_each_prime(4000, 100000, [&](const std::uint64_t p) {
+			stopped.push_back(p);
+			return p < 4090;
+		});
+		CHECK(stopped == std::vector<std::uint64_t> {4001, 4003, 4007, 4013, 4019, 4021, 4027, 4049, 4051, 4057, 4073, 4079, 4091});
+	}
+	SUBCASE("Replaces files with a bad header")
+	{
+		{
+			std::ofstream corrupt(path, std::ios::binary);
+			corrupt << "not a prime table";
+		}
+		utils::prime_table_cache cache(path, 100);
+		CHECK(cache.limit() == 100);
+		CHECK(cache.is_prime(97));
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_SUITE_END;
@@ -20,4 +20,342 @@ TEST_CASE("Test prime_count_map function.") {
 		std::map<int, int> primes_for_1672056 {{2, 3}, {3,3}, {7741, 1}};
 		CHECK(utils::prime_count_map(1672056) == primes_for_1672056);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test fixed-capacity factorization.") {
+	static_assert(utils::factorization::capacity == 15);
+	static_assert(utils::basic_factorization<int>::capacity == 9);
+
+	SUBCASE("Sorted insertion and map-style access")
+	{
+		utils::factorization factors {};
+		factors.add(7);
+		factors.add(2, 3);
+		factors.add(7);
+		factors.add(5);
+		CHECK(factors.size() == 3);
+		CHECK(factors.front() == std::pair<std::uint64_t, int> {2, 3});
+		CHECK(factors.at(7) == 2);
+		CHECK(factors.exponent_of(3) == 0);
+		CHECK_FALSE(factors.contains(3));
+		CHECK_THROWS_AS((void) factors.at(3), std::out_of_range);
+		CHECK(factors.to_map<int, int>() == std::map<int, int> {{2, 3}, {5, 1}, {7, 2}});
+
+		std::ostringstream printed;
+		printed << factors;
+		CHECK(printed.str() == "{2: 3, 5: 1, 7: 2, }");
+	}
+	SUBCASE("Overflowing the capacity throws")
+	{
+		utils::basic_factorization<int> factors {};
+		for (const int prime : {2, 3, 5, 7, 11, 13, 17, 19, 23}) {
+			factors.add(prime);
+		}
+		CHECK_THROWS_AS(factors.add(29), std::length_error);
+	}
+}
+
+TEST_CASE("Test wheel trial division.") {
+	SUBCASE("Matches Pollard-Brent factorization")
+	{
+		bool all_match = true;
+		for (std::uint32_t n = 0; n <= 100000; n++) {
+			all_match = all_match && utils::trial_division_factorize(n) == utils::factorize(n);
+		}
+		std::uint32_t n = 2463534242;
+		for (int i = 0; i < 2000; i++) {
+			n ^= n << 13;
+			n ^= n >> 17;
+			n ^= n << 5;
+			all_match = all_match && utils::trial_division_factorize(n) == utils::factorize(n);
+		}
+		CHECK(all_match);
+	}
+	SUBCASE("Wheel edge cases")
+	{
+		CHECK(utils::trial_division_factorize(4293001441U).to_map() == std::map<std::uint32_t, int> {{65521, 2}});
+		CHECK(utils::trial_division_factorize(4294967291U).to_map() == std::map<std::uint32_t, int> {{4294967291U, 1}});
+		CHECK(utils::trial_division_factorize(121 * 11 * 210).to_map() == std::map<std::uint32_t, int> {{2, 1}, {3, 1}, {5, 1}, {7, 1}, {11, 3}});
+		CHECK(utils::trial_division_factorize(1).empty());
+	}
+}
+
+TEST_CASE("Test compile-time prime tables.") {
+	SUBCASE("Primes below 2^16")
+	{
+		CHECK(utils::small_primes.front() == 2);
+		CHECK(utils::small_primes.back() == 65521);
+		static_assert(utils::prime_count_below<1000> == 168);
+		static_assert(utils::make_prime_table<30, std::uint8_t>() == std::array<std::uint8_t, 10> {2, 3, 5, 7, 11, 13, 17, 19, 23, 29});
+		CHECK(std::ranges::equal(utils::small_primes, utils::primes_up_to(65535)));
+	}
+	SUBCASE("Smallest prime factors")
+	{
+		constexpr auto spf = utils::make_spf_table<1000, std::uint16_t>();
+		static_assert(spf[0] == 0 && spf[1] == 0 && spf[2] == 2 && spf[91] == 7 && spf[997] == 997 && spf[999] == 3);
+		const utils::spf_table table(1000);
+		for (std::uint32_t n = 0; n <= 1000; n++) {
+			CHECK(spf[n] == table.smallest_prime_factor(n));
+		}
+	}
+	SUBCASE("Constant-evaluated factorization")
+	{
+		constexpr auto factors = utils::factorize_constexpr<std::uint64_t>(600851475143);
+		static_assert(factors.size() == 4 && factors.front().first == 71 && factors.back().first == 6857);
+		static_assert(utils::factorize_constexpr<std::uint32_t>(4294967295U).back().first == 65537);
+		static_assert(utils::factorize_constexpr<std::uint32_t>(4294967291U).size() == 1);
+		static_assert(utils::factorize_constexpr(1).empty());
+		static_assert(utils::factorize_constexpr(232792560).exponent_of(2) == 4);
+		CHECK(utils::factorize_constexpr<std::uint64_t>(1000003ULL * 1000033 * 8) == utils::factorize_u64(1000003ULL * 1000033 * 8));
+	}
+}
+
+TEST_CASE("Test prime_sieve table.") {
+	SUBCASE("Small tables")
+	{
+		CHECK(utils::prime_sieve(1).count() == 0);
+		CHECK(utils::prime_sieve(2).count() == 1);
+		CHECK(utils::prime_sieve(30).primes() == std::vector<std::uint64_t> {2, 3, 5, 7, 11, 13, 17, 19, 23, 29});
+	}
+	SUBCASE("Prime counts across many segments")
+	{
+		const utils::prime_sieve sieve(10000000, 1024);
+		CHECK(sieve.count() == 664579);
+		CHECK(sieve.is_prime(9999991));
+		CHECK_FALSE(sieve.is_prime(9999993));
+		CHECK_FALSE(sieve.is_prime(1));
+		CHECK(utils::primes_up_to(1000000).size() == 78498);
+	}
+}
+
+TEST_CASE("Test segmented for_each_prime ranges.") {
+	SUBCASE("Window above 1e12")
+	{
+		std::vector<std::uint64_t> primes {};
+		utils::for_each_prime(1000000000000, 1000000001000, [&](const std::uint64_t p) { primes.push_back(p); });
+		CHECK(primes.size() == 37);
+		CHECK(primes.front() == 1000000000039);
+		CHECK(primes.back() == 1000000000997);
+	}
+	SUBCASE("Unaligned bounds and early stop")
+	{
+		std::vector<std::uint64_t> primes {};
+		utils::for_each_prime(3, 23, [&](const std::uint64_t p) { primes.push_back(p); });
+		CHECK(primes == std::vector<std::uint64_t> {3, 5, 7, 11, 13, 17, 19, 23});
+
+		std::size_t visited = 0;
+		utils::for_each_prime(1000000000, 1000009999, [&](std::uint64_t) { visited++; });
+		CHECK(visited == 487);
+
+		std::uint64_t first = 0;
+		utils::for_each_prime(1000000, 2000000, [&](const std::uint64_t p) { first = p; return false; });
+		CHECK(first == 1000003);
+	}
+}
+
+TEST_CASE("Test lazy prime view.") {
+	static_assert(std::ranges::input_range<utils::views::prime_view>);
+	static_assert(std::ranges::view<utils::views::prime_view>);
+
+	SUBCASE("Composes with standard views")
+	{
+		std::vector<std::uint64_t> below_50 {};
+		for (const std::uint64_t p : utils::views::primes() | std::views::take_while([](std::uint64_t p) { return p < 50; })) {
+			below_50.push_back(p);
+		}
+		CHECK(below_50 == std::vector<std::uint64_t> {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47});
+
+		std::vector<std::uint64_t> one_mod_4 {};
+		for (const std::uint64_t p : utils::views::primes() | std::views::filter([](std::uint64_t p) { return p % 4 == 1; }) | std::views::take(5)) {
+			one_mod_4.push_back(p);
+		}
+		CHECK(one_mod_4 == std::vector<std::uint64_t> {5, 13, 17, 29, 37});
+	}
+	SUBCASE("Starts anywhere and crosses segments")
+	{
+		std::vector<std::uint64_t> window {};
+		for (const std::uint64_t p : utils::views::primes(1000000000000) | std::views::take(37)) {
+			window.push_back(p);
+		}
+		CHECK(window.front() == 1000000000039);
+		CHECK(window.back() == 1000000000997);
+
+		std::size_t count = 0;
+		for ([[maybe_unused]] const std::uint64_t p : utils::views::primes() | std::views::take_while([](std::uint64_t p) { return p < 10000000; })) {
+			count++;
+		}
+		CHECK(count == 664579);
+	}
+}
+
+TEST_CASE("Test parallel primes_in_range.") {
+	SUBCASE("Matches the sequential sieve")
+	{
+		const std::uint64_t lo = 1000000000000;
+		const std::uint64_t hi = lo + 20000000;
+		std::vector<std::uint64_t> sequential {};
+		utils::for_each_prime(lo, hi, [&](const std::uint64_t p) { sequential.push_back(p); });
+		CHECK(utils::primes_in_range(lo, hi, 4) == sequential);
+		CHECK(utils::primes_in_range(lo, hi, 1) == sequential);
+	}
+	SUBCASE("Small ranges")
+	{
+		CHECK(utils::primes_in_range(0, 30, 8) == std::vector<std::uint64_t> {2, 3, 5, 7, 11, 13, 17, 19, 23, 29});
+		CHECK(utils::primes_in_range(1000000000000, 1000000001000).size() == 37);
+		CHECK(utils::primes_in_range(24, 28).empty());
+	}
+	SUBCASE("Worker exceptions reach the caller")
+	{
+		CHECK_THROWS_AS(utils::for_each_prime_segment_parallel(0, 10000000, [](std::uint64_t index, const utils::prime_segment &) {
+			if (index == 3) {
+				throw std::runtime_error("Segment failure.");
+			}
+		}, 4), std::runtime_error);
+	}
+}
+
+TEST_CASE("Test sublinear prime counting and summing.") {
+	SUBCASE("Matches the sieve")
+	{
+		for (const std::uint64_t x : {0ULL, 1ULL, 2ULL, 3ULL, 4ULL, 24ULL, 25ULL, 97ULL, 1000ULL, 123457ULL, 3000000ULL}) {
+			std::uint64_t count = 0;
+			utils::uint128_t sum = 0;
+			utils::for_each_prime(2, x, [&](const std::uint64_t p) {
+				count++;
+				sum += p;
+			});
+			CHECK(utils::prime_pi(x) == count);
+			CHECK(utils::prime_sum(x) == sum);
+		}
+	}
+	SUBCASE("Known values")
+	{
+		CHECK(utils::prime_sum(2000000) == 142913828922ULL);
+		CHECK(utils::prime_pi(10000000000ULL) == 455052511);
+		CHECK(utils::prime_sum(10000000000ULL) == 2220822432581729238ULL);
+		CHECK(utils::prime_pi(100000000000ULL, 0) == 4118054813ULL);
+	}
+}
+
+TEST_CASE("Test spf_table factorization.") {
+	const utils::spf_table table(2000000);
+
+	SUBCASE("Smallest prime factors")
+	{
+		CHECK(table.smallest_prime_factor(1) == 0);
+		CHECK(table.smallest_prime_factor(2) == 2);
+		CHECK(table.smallest_prime_factor(91) == 7);
+		CHECK(table.is_prime(1999993));
+		CHECK(table.primes().size() == 148933);
+	}
+	SUBCASE("Accelerated prime_count_map matches trial division")
+	{
+		std::map<int, int> primes_for_1672056 {{2, 3}, {3,3}, {7741, 1}};
+		CHECK(utils::prime_count_map(1672056, &table) == primes_for_1672056);
+
+		bool all_match = true;
+		for (int i = 1; i <= 20000; i++) {
+			all_match = all_match && utils::prime_count_map(i, &table) == utils::prime_count_map(i);
+		}
+		CHECK(all_match);
+
+		// Above the table limit it falls back to trial division.
+		std::map<int, int> primes_for_big {{2147483647, 1}};
+		CHECK(utils::prime_count_map(2147483647, &table) == primes_for_big);
+	}
+}
+
+TEST_CASE("Test 64-bit primality and factorization.") {
+	SUBCASE("Miller-Rabin")
+	{
+		CHECK_FALSE(utils::is_prime_u64(1));
+		CHECK(utils::is_prime_u64(2));
+		CHECK(utils::is_prime_u64(1000000007));
+		CHECK(utils::is_prime_u64(18446744073709551557ULL));
+		// Carmichael number and a strong pseudoprime to bases 2, 3, 5 and 7.
+		CHECK_FALSE(utils::is_prime_u64(561));
+		CHECK_FALSE(utils::is_prime_u64(3215031751));
+		CHECK_FALSE(utils::is_prime_u64(18446744030759878681ULL));
+	}
+	SUBCASE("Pollard-Brent")
+	{
+		std::map<std::uint64_t, int> primes_for_600851475143 {{71, 1}, {839, 1}, {1471, 1}, {6857, 1}};
+		CHECK(utils::factorize_u64(600851475143) == primes_for_600851475143);
+
+		std::map<std::uint64_t, int> primes_for_max {{3, 1}, {5, 1}, {17, 1}, {257, 1}, {641, 1}, {65537, 1}, {6700417, 1}};
+		CHECK(utils::factorize_u64(18446744073709551615ULL) == primes_for_max);
+
+		std::map<std::uint64_t, int> primes_for_semiprime {{4294967279, 1}, {4294967291, 1}};
+		CHECK(utils::factorize_u64(18446743979220271189ULL) == primes_for_semiprime);
+
+		std::map<std::uint64_t, int> primes_for_square {{4294967291, 2}};
+		CHECK(utils::factorize_u64(18446744030759878681ULL) == primes_for_square);
+
+		std::map<std::uint64_t, int> primes_for_1 {};
+		CHECK(utils::factorize_u64(1) == primes_for_1);
+	}
+	SUBCASE("prime_count_map routes large ints through Pollard-Brent")
+	{
+		std::map<int, int> primes_for_2147483646 {{2, 1}, {3, 2}, {7, 1}, {11, 1}, {31, 1}, {151, 1}, {331, 1}};
+		CHECK(utils::prime_count_map(2147483646) == primes_for_2147483646);
+		CHECK(utils::prime_count_map(46327 * 46337) == std::map<int, int> {{46327, 1}, {46337, 1}});
+	}
+}
+
+TEST_CASE("Test batch factorization.") {
+	SUBCASE("Matches one-at-a-time factorization")
+	{
+		std::mt19937_64 random(12345);
+		std::vector<std::uint64_t> numbers {0, 1, 2, 65536, 16777259, 4294967291ULL, 4294967296ULL, 1000000007ULL * 998244353};
+		for (int i = 0; i < 5000; i++) {
+			numbers.push_back(random() >> (random() % 64));
+		}
+		for (const unsigned threads : {1U, 4U}) {
+			utils::factorization_batch batch {};
+			utils::factorize_batch(numbers, batch, threads);
+			REQUIRE(batch.size() == numbers.size());
+			REQUIRE(batch.offsets.back() == batch.primes.size());
+			for (std::size_t i = 0; i < numbers.size(); i++) {
+				CHECK(batch[i] == utils::factorize_u64(numbers[i]));
+			}
+		}
+	}
+	SUBCASE("Reused output is replaced")
+	{
+		utils::factorization_batch batch {};
+		const std::vector<std::uint64_t> first {360, 97};
+		utils::factorize_batch(first, batch);
+		utils::factorize_batch(std::span(first).subspan(1), batch);
+		CHECK(batch.size() == 1);
+		CHECK(std::ranges::equal(batch.primes_of(0), std::array<std::uint64_t, 1> {97}));
+		CHECK(std::ranges::equal(batch.exponents_of(0), std::array<std::uint8_t, 1> {1}));
+		utils::factorize_batch({}, batch);
+		CHECK(batch.size() == 0);
+		CHECK_THROWS_AS((void)batch.primes_of(0), std::out_of_range);
+	}
+}
+
+TEST_CASE("Test width-generic primality and factorization.") {
+	SUBCASE("32-bit")
+	{
+		CHECK(utils::is_prime<std::uint32_t>(4294967291U));
+		CHECK_FALSE(utils::is_prime<std::uint32_t>(4294967295U));
+		CHECK(utils::factorize<std::uint32_t>(4294967295U).to_map() == std::map<std::uint32_t, int> {{3, 1}, {5, 1}, {17, 1}, {257, 1}, {65537, 1}});
+	}
+	SUBCASE("128-bit")
+	{
+		static_assert(utils::basic_factorization<utils::uint128_t>::capacity == 26);
+		const utils::uint128_t mersenne_127 = (utils::uint128_t {1} << 127) - 1;
+		const utils::uint128_t mersenne_89 = (utils::uint128_t {1} << 89) - 1;
+		CHECK(utils::is_prime(mersenne_127));
+		CHECK(utils::is_prime(mersenne_89));
+		CHECK_FALSE(utils::is_prime(mersenne_89 * 3));
+
+		const utils::uint128_t big_prime = 18446744073709551557ULL;
+		const auto factors = utils::factorize(big_prime * 1000000007 * 9);
+		CHECK(factors.size() == 3);
+		CHECK(factors.at(3) == 2);
+		CHECK(factors.at(1000000007) == 1);
+		CHECK(factors.at(big_prime) == 1);
+	}
+}